@@ -1,98 +1,399 @@
+#include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include "libs/LibQueue.h"
-#include "libs/LibStack.h"
+#include "LibQueue.h"
+#include "LibStack.h"
 
-// some global constants
-const int maxHangar = 5;
-const int maxRunway = 7;
+// default capacities of the original assignment
+const int defaultHangarCapacity = 5;
+const int defaultRunwayCapacity = 7;
+
+// binary input: this magic, the number of planes as a little-endian
+// uint64, then per plane its id (little-endian int32) and 'y' or 'n'
+const char binaryMagic[8] = {'P', 'L', 'A', 'N', 'E', 'S', '0', '1'};
+
+#define IO_BUFFER_SIZE (1 << 22)
+
+/*
+ * Planes needing repair go to hangar (id mod hangars), the others to
+ * runway (id mod runways); hangar h is emptied onto runway (h mod
+ * runways). With one hangar and one runway these are the original rules.
+ */
+typedef struct Airport {
+  int hangarCapacity;
+  int runwayCapacity;
+  int hangars;
+  int runways;
+  Stack* hangar;
+  Queue* runway;
+} Airport;
+
+/*
+ * @brief Large output buffer, written out with one fwrite when full
+ */
+typedef struct Writer {
+  FILE* file;
+  char* buffer;
+  size_t length;
+} Writer;
 
 /*
- * @brief Frees runway by giving takeoff signal
+ * @brief Large input buffer for parsing text or reading binary records
+ */
+typedef struct Reader {
+  FILE* file;
+  unsigned char* buffer;
+  size_t position;
+  size_t length;
+} Reader;
+
+void flushWriter(Writer* w) {
+  fwrite(w->buffer, 1, w->length, w->file);
+  w->length = 0;
+}
+
+void writeString(Writer* w, const char* s) {
+  size_t n = strlen(s);
+  if (w->length + n > IO_BUFFER_SIZE) {
+    flushWriter(w);
+  }
+  memcpy(w->buffer + w->length, s, n);
+  w->length += n;
+}
+
+/*
+ * @brief Writes n and a newline, formatting the digits by hand
+ */
+void writeLine(Writer* w, int n) {
+  char digits[12];
+  int len = 0;
+  unsigned int u = n < 0 ? 0u - (unsigned int)n : (unsigned int)n;
+  do {
+    digits[len++] = '0' + u % 10;
+    u /= 10;
+  } while (u > 0);
+  if (w->length + len + 2 > IO_BUFFER_SIZE) {
+    flushWriter(w);
+  }
+  if (n < 0) {
+    w->buffer[w->length++] = '-';
+  }
+  while (len > 0) {
+    w->buffer[w->length++] = digits[--len];
+  }
+  w->buffer[w->length++] = '\n';
+}
+
+/*
+ * @brief Returns the next input byte without consuming it, or EOF
+ */
+int peekByte(Reader* r) {
+  if (r->position == r->length) {
+    r->length = fread(r->buffer, 1, IO_BUFFER_SIZE, r->file);
+    r->position = 0;
+    if (r->length == 0) {
+      return EOF;
+    }
+  }
+  return r->buffer[r->position];
+}
+
+void skipSpace(Reader* r) {
+  int c;
+  while ((c = peekByte(r)) == ' ' || c == '\n' || c == '\t' || c == '\r') {
+    r->position++;
+  }
+}
+
+/*
+ * @brief Parses a decimal integer, like scanf("%d")
+ * @return 1 on success, 0 at the end of the input
+ */
+int readInt(Reader* r, int* value) {
+  skipSpace(r);
+  int negative = peekByte(r) == '-';
+  if (negative) {
+    r->position++;
+  }
+  int c = peekByte(r);
+  if (c < '0' || c > '9') {
+    return 0;
+  }
+  unsigned int u = 0;
+  while ((c = peekByte(r)) >= '0' && c <= '9') {
+    u = 10 * u + (c - '0');
+    r->position++;
+  }
+  *value = negative ? (int)(0u - u) : (int)u;
+  return 1;
+}
+
+/*
+ * @brief Reads a word and returns its first letter, or EOF
+ */
+int readWord(Reader* r) {
+  skipSpace(r);
+  int first = peekByte(r);
+  int c;
+  while ((c = peekByte(r)) != EOF && c != ' ' && c != '\n' && c != '\t' && c != '\r') {
+    r->position++;
+  }
+  return first;
+}
+
+/*
+ * @brief Copies the next n bytes of the input
+ * @return 1 on success, 0 if the input ends first
+ */
+int readBytes(Reader* r, void* out, size_t n) {
+  unsigned char* o = out;
+  while (n > 0) {
+    if (peekByte(r) == EOF) {
+      return 0;
+    }
+    size_t chunk = r->length - r->position < n ? r->length - r->position : n;
+    memcpy(o, r->buffer + r->position, chunk);
+    r->position += chunk;
+    o += chunk;
+    n -= chunk;
+  }
+  return 1;
+}
+
+/*
+ * @brief Frees a runway by giving the takeoff signal
  *
- * @param count Pointer to the number of planes in the runway
- * @param q Runway queue
+ * @param a The airport
+ * @param r Number of the runway
+ * @param w Output
  */
-void freeRunway(int* count, Queue q) {
+void freeRunway(Airport* a, int r, Writer* w) {
+  Queue q = a->runway[r];
   if (!isEmptyQueue(q)) {
-    printf("Ready for takeoff!\n");
-    while (!isEmptyQueue(q)) {
-      printf("%d\n", dequeue(q));
+    if (a->runways == 1) {
+      writeString(w, "Ready for takeoff!\n");
+    } else {
+      char header[48];
+      snprintf(header, sizeof(header), "Ready for takeoff on runway %d!\n", r);
+      writeString(w, header);
+    }
+    int planes[64];
+    int m;
+    while ((m = dequeueMany(planes, 64, q)) > 0) {
+      for (int i = 0; i < m; i++) {
+        writeLine(w, planes[i]);
+      }
     }
-    *count = 0;
   }
 }
 
 /*
- * @brief Frees Hangar by moving all planes to the waiting runway
+ * @brief Frees a hangar by moving all its planes to its runway
  *
- * @param stackCount Pointer to the number of planes in the hangar
- * @param queueCount Pointer to the number of planes in the waiting runway
- * @param s Hangar stack
- * @param q Runway queue
+ * @param a The airport
+ * @param h Number of the hangar
  */
-void freeHangar(int* stackCount, int* queueCount, Stack s, Queue q) {
+void freeHangar(Airport* a, int h) {
+  Stack s = a->hangar[h];
+  Queue q = a->runway[h % a->runways];
   while (!isEmptyStack(s)) {
     enqueue(pop(s), q);
-    (*stackCount)--;
-    (*queueCount)++;
   }
 }
 
 /*
- * @brief Main simulation for airport management
+ * @brief Handles one arriving plane
  *
- * Reads input planes, decides whether they go to the hangar
- * or runway, handles capacity of both, and runs end-of-day cleanup
+ * @param a The airport
+ * @param id Id of the plane
+ * @param repair 'y' if the plane needs repair, 'n' if not
+ * @param w Output
  */
-int main(void) {
-  int n;  // number of planes to read
-  int id;
-  char repair[6];  // string to store user input
+void arrive(Airport* a, int id, int repair, Writer* w) {
+  // If plane needs repair, place it in its hangar
+  if (repair == 'y') {
+    int h = (unsigned int)id % a->hangars;
+    int r = h % a->runways;
+    if (lengthStack(a->hangar[h]) >= a->hangarCapacity) {
+      freeRunway(a, r, w);
+      freeHangar(a, h);
+    }
+    push(id, a->hangar[h]);
+    if (lengthStack(a->hangar[h]) >= a->hangarCapacity) {
+      freeRunway(a, r, w);
+      freeHangar(a, h);
+    }
+  }
+  // Otherwise, place it in its waiting runway
+  else if (repair == 'n') {
+    int r = (unsigned int)id % a->runways;
+    if (lengthQueue(a->runway[r]) >= a->runwayCapacity) {
+      freeRunway(a, r, w);
+    }
+    enqueue(id, a->runway[r]);
+    if (lengthQueue(a->runway[r]) >= a->runwayCapacity) {
+      freeRunway(a, r, w);
+    }
+  }
+}
 
-  // airport structures
-  Stack hangar = newStack();
-  int hangarCount = 0;  // planes in the hangar
-  Queue waitingRunway = newQueue();
-  int runwayCount = 0;  // planes in the waiting runway
-
-  scanf("%d", &n);  // input: number of planes for the day
-
-  for (int i = 0; i < n; i++) {
-    scanf("%d %5s", &id, repair);
-    // If plane needs repair, place it in the hangar
-    if (repair[0] == 'y') {
-      if (hangarCount == maxHangar) {
-        freeRunway(&runwayCount, waitingRunway);
-        freeHangar(&hangarCount, &runwayCount, hangar, waitingRunway);
-      }
-      push(id, hangar);
-      hangarCount++;
-      if (hangarCount == maxHangar) {
-        freeRunway(&runwayCount, waitingRunway);
-        freeHangar(&hangarCount, &runwayCount, hangar, waitingRunway);
-      }
+/*
+ * @brief End of the day: every plane takes off
+ */
+void closeAirport(Airport* a, Writer* w) {
+  for (int r = 0; r < a->runways; r++) {
+    freeRunway(a, r, w);
+  }
+  for (int h = 0; h < a->hangars; h++) {
+    freeHangar(a, h);
+  }
+  for (int r = 0; r < a->runways; r++) {
+    freeRunway(a, r, w);
+  }
+}
+
+/*
+ * @brief Reads the planes of the day and runs the simulation
+ *
+ * @param binary 1 for the binary format, 0 for "n" followed by n lines "id yes/no"
+ */
+void simulate(Airport* a, Reader* in, int binary, Writer* w) {
+  if (binary) {
+    unsigned char header[16];
+    if (!readBytes(in, header, 16) || memcmp(header, binaryMagic, 8) != 0) {
+      fprintf(stderr, "not a binary planes file\n");
+      exit(1);
     }
-    // Otherwise, place it in the waiting runway
-    else if (repair[0] == 'n') {
-      if (runwayCount == maxRunway) {
-        freeRunway(&runwayCount, waitingRunway);
-      }
-      enqueue(id, waitingRunway);
-      runwayCount++;
-      if (runwayCount == maxRunway) {
-        freeRunway(&runwayCount, waitingRunway);
+    uint64_t n = 0;
+    for (int i = 15; i >= 8; i--) {
+      n = n << 8 | header[i];
+    }
+    unsigned char copy[5];
+    for (uint64_t i = 0; i < n; i++) {
+      // records are usually whole in the buffer; only copy those that straddle a refill
+      const unsigned char* record = in->buffer + in->position;
+      if (in->length - in->position >= 5) {
+        in->position += 5;
+      } else if (readBytes(in, copy, 5)) {
+        record = copy;
+      } else {
+        break;
       }
+      int32_t id = (int32_t)((uint32_t)record[0] | (uint32_t)record[1] << 8 | (uint32_t)record[2] << 16 | (uint32_t)record[3] << 24);
+      arrive(a, id, record[4], w);
+    }
+  } else {
+    int n = 0;  // number of planes to read
+    int id;
+    readInt(in, &n);
+    for (int i = 0; i < n && readInt(in, &id); i++) {
+      arrive(a, id, readWord(in), w);
+    }
+  }
+  closeAirport(a, w);
+}
+
+/*
+ * @brief Converts text input to the binary format
+ */
+void writeBinary(Reader* in, FILE* out) {
+  int n = 0;
+  int id;
+  readInt(in, &n);
+  unsigned char header[16];
+  memcpy(header, binaryMagic, 8);
+  for (int i = 0; i < 8; i++) {
+    header[8 + i] = ((uint64_t)n >> (8 * i)) & 0xff;
+  }
+  fwrite(header, 1, 16, out);
+  for (int i = 0; i < n && readInt(in, &id); i++) {
+    unsigned char record[5] = {id & 0xff, (id >> 8) & 0xff, (id >> 16) & 0xff, ((uint32_t)id >> 24) & 0xff, 0};
+    record[4] = readWord(in);
+    fwrite(record, 1, 5, out);
+  }
+}
+
+void usage(const char* name) {
+  fprintf(stderr,
+          "usage: %s [--hangars K] [--runways M] [--hangar-capacity H] [--runway-capacity R] [--binary]\n"
+          "       %s --write-binary FILE   (converts text input)\n",
+          name, name);
+  exit(1);
+}
+
+/*
+ * @brief Main simulation for airport management
+ *
+ * Reads input planes, decides whether they go to a hangar or a runway,
+ * handles the capacities of both, and runs end-of-day cleanup
+ */
+int main(int argc, char* argv[]) {
+  Airport a = {defaultHangarCapacity, defaultRunwayCapacity, 1, 1, NULL, NULL};
+  int binary = 0;
+  const char* binaryOut = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--binary") == 0) {
+      binary = 1;
+    } else if (i + 1 < argc && strcmp(argv[i], "--write-binary") == 0) {
+      binaryOut = argv[++i];
+    } else if (i + 1 < argc && strcmp(argv[i], "--hangars") == 0) {
+      a.hangars = atoi(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--runways") == 0) {
+      a.runways = atoi(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--hangar-capacity") == 0) {
+      a.hangarCapacity = atoi(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--runway-capacity") == 0) {
+      a.runwayCapacity = atoi(argv[++i]);
+    } else {
+      usage(argv[0]);
     }
   }
+  if (a.hangars < 1 || a.runways < 1 || a.hangarCapacity < 1 || a.runwayCapacity < 1) {
+    usage(argv[0]);
+  }
 
-  // End of the day
-  freeRunway(&runwayCount, waitingRunway);
-  freeHangar(&hangarCount, &runwayCount, hangar, waitingRunway);
-  freeStack(hangar);
-  freeRunway(&runwayCount, waitingRunway);
-  freeQueue(waitingRunway);
+  Reader in = {stdin, malloc(IO_BUFFER_SIZE), 0, 0};
+  assert(in.buffer != NULL);
+  if (binaryOut != NULL) {
+    FILE* out = fopen(binaryOut, "wb");
+    if (out == NULL) {
+      perror(binaryOut);
+      exit(1);
+    }
+    writeBinary(&in, out);
+    fclose(out);
+    free(in.buffer);
+    return 0;
+  }
+
+  // airport structures
+  a.hangar = malloc(a.hangars * sizeof(Stack));
+  a.runway = malloc(a.runways * sizeof(Queue));
+  assert(a.hangar != NULL && a.runway != NULL);
+  for (int h = 0; h < a.hangars; h++) {
+    a.hangar[h] = newStack();
+  }
+  for (int r = 0; r < a.runways; r++) {
+    a.runway[r] = newQueue();
+  }
+  Writer w = {stdout, malloc(IO_BUFFER_SIZE), 0};
+  assert(w.buffer != NULL);
+
+  simulate(&a, &in, binary, &w);
+  flushWriter(&w);
+
+  for (int h = 0; h < a.hangars; h++) {
+    freeStack(a.hangar[h]);
+  }
+  for (int r = 0; r < a.runways; r++) {
+    freeQueue(a.runway[r]);
+  }
+  free(a.hangar);
+  free(a.runway);
+  free(in.buffer);
+  free(w.buffer);
   return 0;
 }
@@ -0,0 +1,82 @@
+/**
+ * @file  genplanes.c
+ * @brief Generates large airport inputs for benchmarking.
+ *
+ * Writes N planes with random ids in [0, MAXID), a fraction REPAIR of
+ * which need repair, in the text format of the tests or (with -b) in the
+ * binary format read by "airport --binary".
+ *
+ * usage: genplanes [-n PLANES] [-r REPAIR] [-i MAXID] [-s SEED] [-b]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint64_t rngState = 88172645463325252ull;
+
+/*
+ * @brief Returns the next value of a xorshift64* generator.
+ */
+uint64_t nextRandom(void) {
+  rngState ^= rngState >> 12;
+  rngState ^= rngState << 25;
+  rngState ^= rngState >> 27;
+  return rngState * 2685821657736338717ull;
+}
+
+int main(int argc, char* argv[]) {
+  long planes = 1000000;
+  double repair = 0.4;
+  uint64_t maxId = 1000000000;
+  int binary = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-b") == 0) {
+      binary = 1;
+    } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+      planes = atol(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) {
+      repair = atof(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "-i") == 0) {
+      maxId = strtoull(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+      rngState ^= strtoull(argv[++i], NULL, 10) * 0x9E3779B97F4A7C15ull;
+    } else {
+      fprintf(stderr, "usage: %s [-n PLANES] [-r REPAIR] [-i MAXID] [-s SEED] [-b]\n", argv[0]);
+      return 1;
+    }
+  }
+  uint64_t threshold = (uint64_t)(repair * 4294967296.0);
+
+  static unsigned char buffer[1 << 20];
+  size_t length = 0;
+  if (binary) {
+    memcpy(buffer, "PLANES01", 8);
+    for (int i = 0; i < 8; i++) {
+      buffer[8 + i] = ((uint64_t)planes >> (8 * i)) & 0xff;
+    }
+    length = 16;
+  } else {
+    length = sprintf((char*)buffer, "%ld\n", planes);
+  }
+  for (long p = 0; p < planes; p++) {
+    uint64_t r = nextRandom();
+    uint32_t id = (uint32_t)((r >> 32) % maxId);
+    int needsRepair = (r & 0xffffffffu) < threshold;
+    if (length + 32 > sizeof(buffer)) {
+      fwrite(buffer, 1, length, stdout);
+      length = 0;
+    }
+    if (binary) {
+      for (int i = 0; i < 4; i++) {
+        buffer[length++] = (id >> (8 * i)) & 0xff;
+      }
+      buffer[length++] = needsRepair ? 'y' : 'n';
+    } else {
+      length += sprintf((char*)buffer + length, "%u %s\n", id, needsRepair ? "yes" : "no");
+    }
+  }
+  fwrite(buffer, 1, length, stdout);
+  return 0;
+}
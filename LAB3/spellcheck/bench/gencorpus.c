@@ -0,0 +1,249 @@
+/**
+ * @file  gencorpus.c
+ * @brief Generates large spellcheck inputs for benchmarking.
+ *
+ * The output has the same format as the spellcheck tests: a dictionary of
+ * distinct random words, a line with '%', and a text whose words are drawn
+ * from the dictionary with a Zipf distribution. A tunable fraction of the
+ * text words is misspelled by one random edit (substitution, insertion,
+ * deletion or transposition of neighbouring letters).
+ *
+ * usage: gencorpus [-w WORDS] [-t TEXTWORDS] [-z ZIPF] [-m MISSRATE] [-s SEED]
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_LENGTH 3
+#define MAX_LENGTH 14
+
+uint64_t rngState = 88172645463325252ull;
+
+/*
+ * @brief Returns the next value of a xorshift64* generator.
+ */
+uint64_t nextRandom(void) {
+  rngState ^= rngState >> 12;
+  rngState ^= rngState << 25;
+  rngState ^= rngState >> 27;
+  return rngState * 2685821657736338717ull;
+}
+
+/*
+ * @brief Returns a uniformly distributed integer in [0, n).
+ */
+uint32_t randomBelow(uint32_t n) {
+  return (uint32_t)(((nextRandom() >> 32) * n) >> 32);
+}
+
+/*
+ * @brief Returns a uniformly distributed double in [0, 1).
+ */
+double randomUnit(void) {
+  return (nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * @brief Returns a random letter, roughly following English letter frequencies.
+ */
+char randomLetter(void) {
+  static const char letters[] = "eeeeeeeeeeeetttttttttaaaaaaaaooooooooiiiiiiinnnnnnnsssssshhhhhhrrrrrrddddllllcccuuummwwffggyyppbbvkjxqz";
+  return letters[randomBelow(sizeof(letters) - 1)];
+}
+
+/*
+ * @brief Hashes a word (FNV-1a) for the duplicate check.
+ */
+uint64_t hashString(const char* s) {
+  uint64_t h = 14695981039346656037ull;
+  for (; *s != '\0'; s++) {
+    h ^= (unsigned char)*s;
+    h *= 1099511628211ull;
+  }
+  return h | 1;  // 0 marks an empty slot
+}
+
+/*
+ * @brief Generates n distinct random words.
+ *
+ * @param n	Number of words.
+ *
+ * @return Array of n words, each a char[MAX_LENGTH + 1].
+ */
+char (*generateWords(uint32_t n))[MAX_LENGTH + 1] {
+  char(*words)[MAX_LENGTH + 1] = malloc((size_t)n * sizeof(*words));
+  size_t capacity = 1;
+  while (capacity < 2 * (size_t)n) {
+    capacity *= 2;
+  }
+  uint64_t* seen = calloc(capacity, sizeof(uint64_t));
+  if (!words || !seen) {
+    exit(1);
+  }
+
+  uint32_t count = 0;
+  while (count < n) {
+    int len = MIN_LENGTH + randomBelow(MAX_LENGTH - MIN_LENGTH + 1);
+    for (int i = 0; i < len; i++) {
+      words[count][i] = randomLetter();
+    }
+    words[count][len] = '\0';
+
+    // words with the same hash are treated as duplicates, which only skips a few
+    uint64_t h = hashString(words[count]);
+    size_t slot = h & (capacity - 1);
+    while (seen[slot] != 0 && seen[slot] != h) {
+      slot = (slot + 1) & (capacity - 1);
+    }
+    if (seen[slot] == 0) {
+      seen[slot] = h;
+      count++;
+    }
+  }
+
+  free(seen);
+  return words;
+}
+
+/*
+ * @brief Applies one random edit to a word.
+ *
+ * @param word	Buffer of at least MAX_LENGTH + 2 characters.
+ */
+void misspell(char* word) {
+  int len = strlen(word);
+  int pos = randomBelow(len);
+
+  switch (randomBelow(4)) {
+    case 0:  // substitution
+      word[pos] = 'a' + (word[pos] - 'a' + 1 + randomBelow(25)) % 26;
+      break;
+    case 1:  // insertion
+      memmove(word + pos + 1, word + pos, len - pos + 1);
+      word[pos] = randomLetter();
+      break;
+    case 2:  // deletion
+      if (len > 1) {
+        memmove(word + pos, word + pos + 1, len - pos);
+      }
+      break;
+    default:  // transposition
+      if (pos + 1 < len && word[pos] != word[pos + 1]) {
+        char tmp = word[pos];
+        word[pos] = word[pos + 1];
+        word[pos + 1] = tmp;
+      } else {
+        word[pos] = 'a' + (word[pos] - 'a' + 1) % 26;
+      }
+      break;
+  }
+}
+
+/*
+ * @brief Prints the command line options to stderr.
+ */
+void usage(const char* prog) {
+  fprintf(stderr, "usage: %s [-w WORDS] [-t TEXTWORDS] [-z ZIPF] [-m MISSRATE] [-s SEED]\n", prog);
+  fprintf(stderr, "  -w WORDS      dictionary size (default 100000)\n");
+  fprintf(stderr, "  -t TEXTWORDS  number of words in the text (default 1000000)\n");
+  fprintf(stderr, "  -z ZIPF       Zipf exponent of the word frequencies (default 1.0)\n");
+  fprintf(stderr, "  -m MISSRATE   fraction of misspelled text words (default 0.05)\n");
+  fprintf(stderr, "  -s SEED       random seed (default 1)\n");
+}
+
+int main(int argc, char* argv[]) {
+  uint32_t nWords = 100000;
+  uint64_t nText = 1000000;
+  double zipf = 1.0;
+  double missRate = 0.05;
+  uint64_t seed = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (strcmp(argv[i], "-w") == 0) {
+      nWords = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      nText = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "-z") == 0) {
+      zipf = strtod(argv[++i], NULL);
+    } else if (strcmp(argv[i], "-m") == 0) {
+      missRate = strtod(argv[++i], NULL);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (nWords == 0 || zipf < 0 || missRate < 0 || missRate > 1) {
+    usage(argv[0]);
+    return 1;
+  }
+  rngState ^= seed * 0x9e3779b97f4a7c15ull;
+
+  char(*words)[MAX_LENGTH + 1] = generateWords(nWords);
+  for (uint32_t i = 0; i < nWords; i++) {
+    printf("%s\n", words[i]);
+  }
+  printf("%%\n");
+
+  // cdf[r] = P(rank <= r); rank r is mapped to a random word, so frequent
+  // words are spread over the whole dictionary
+  double* cdf = malloc(nWords * sizeof(double));
+  uint32_t* wordOfRank = malloc(nWords * sizeof(uint32_t));
+  if (!cdf || !wordOfRank) {
+    exit(1);
+  }
+
+  double sum = 0;
+  for (uint32_t r = 0; r < nWords; r++) {
+    sum += 1.0 / pow(r + 1, zipf);
+    cdf[r] = sum;
+    wordOfRank[r] = r;
+  }
+  for (uint32_t r = nWords - 1; r > 0; r--) {
+    uint32_t j = randomBelow(r + 1);
+    uint32_t tmp = wordOfRank[r];
+    wordOfRank[r] = wordOfRank[j];
+    wordOfRank[j] = tmp;
+  }
+
+  char word[MAX_LENGTH + 2];
+  for (uint64_t i = 0; i < nText; i++) {
+    double u = randomUnit() * sum;
+    uint32_t lo = 0, hi = nWords - 1;
+    while (lo < hi) {  // first rank with cdf >= u
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (cdf[mid] < u) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    strcpy(word, words[wordOfRank[lo]]);
+    if (randomUnit() < missRate) {
+      misspell(word);
+    }
+
+    fputs(word, stdout);
+    putchar(i % 12 == 11 ? '\n' : (i % 7 == 6 ? ',' : ' '));
+    if (i % 7 == 6) {
+      putchar(' ');
+    }
+  }
+  putchar('\n');
+
+  free(cdf);
+  free(wordOfRank);
+  free(words);
+  return 0;
+}
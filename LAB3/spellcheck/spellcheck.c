@@ -11,6 +11,18 @@
  * Part 2: Replaces array-based dictionary with a Trie, improving
  * lookup efficiency from O(n) to O(L) where L is the word length.
  *
+ * Precompiled dictionary:
+ * `spellcheck --compile-dict FILE` reads the dictionary part of the input,
+ * builds the Trie and writes it to FILE as a flat, position-independent
+ * image. `spellcheck --dict FILE` maps such an image with mmap and checks
+ * the text on stdin directly against it, so no Trie has to be built.
+ * With --bloom the image also holds the Bloom filter, which is then mapped
+ * along with the nodes instead of being rebuilt on every start.
+ *
+ * Unknown words are printed as soon as they are found. With --report each
+ * distinct unknown word is printed once, in first-seen order, followed by
+ * its number of occurrences and the position of the first one.
+ *
  * BONUS:
  * When enableColor = true, the program prints the full input text with the
  * unknown words in red. This does not affect the required output and is
@@ -20,18 +32,278 @@
  * Course: Data Structures and Algorithms (Lab 3)
  */
 
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // M_LN2
+
 #include <ctype.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 
 // maximum length for a word
 #define LENGTH 45
 
+// largest --suggest value accepted
+#define MAX_SUGGEST 1000
+
 // BONUS toggle - must be FALSE for CodeGrade auto-tests
 bool enableColor = false;
 
+/*
+ * @brief Returns the time in seconds from a monotonic clock.
+ */
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * @brief Reports a failed allocation and ends the program.
+ */
+void outOfMemory(void) {
+  fprintf(stderr, "spellcheck: out of memory\n");
+  exit(1);
+}
+
+/*
+ * ============================================================================
+ *                               BLOOM FILTER
+ * ============================================================================
+ *
+ * Blocked Bloom filter: every word hashes to one 512-bit block (one cache
+ * line) and sets k bits inside it, so a lookup touches a single cache line.
+ * A negative answer proves the word is not in the dictionary; a positive
+ * answer must still be confirmed by the Trie.
+ */
+
+#define BLOOM_BLOCK_WORDS 8  // 8 * 64 bits = one 64-byte cache line
+#define BLOOM_BLOCK_BITS (BLOOM_BLOCK_WORDS * 64)
+#define BLOOM_MAX_K 16
+
+/*
+ * @struct Bloom
+ * @brief Blocked Bloom filter over the dictionary words.
+ *
+ * @var blocks		nBlocks cache-line aligned blocks of BLOOM_BLOCK_WORDS words
+ * @var nBlocks		number of blocks
+ * @var k		number of bits set per word
+ * @var fpr		false-positive rate the filter was sized for
+ * @var owned		true if blocks is freed with the filter, false if it lies
+ * 			in a mapped dictionary image
+ */
+typedef struct Bloom {
+  uint64_t* blocks;
+  uint32_t nBlocks;
+  int k;
+  double fpr;
+  bool owned;
+} Bloom;
+
+/*
+ * @brief Expected false-positive rate of a blocked filter.
+ *
+ * The words land in the blocks like a Poisson variable of mean
+ * n / nBlocks, and a block holding i words answers like a classic filter
+ * of BLOOM_BLOCK_BITS bits holding i words. The fuller blocks make the
+ * rate higher than that of a classic filter of the same size.
+ *
+ * @param n		Number of words.
+ * @param nBlocks	Number of blocks, at least 1.
+ * @param k		Number of bits set per word.
+ *
+ * @return The false-positive rate.
+ */
+double blockedFpr(uint32_t n, uint32_t nBlocks, int k) {
+  double lambda = (double)n / nBlocks;
+  double spread = 10 * sqrt(lambda) + 10;
+  int first = lambda > spread ? (int)(lambda - spread) : 0;
+  int last = (int)(lambda + spread);
+
+  double fpr = 0;
+  for (int i = first; i <= last; i++) {
+    // Poisson probability of i words, in logs so large means do not underflow
+    double p = exp(i * log(lambda) - lambda - lgamma(i + 1.0));
+    fpr += p * pow(1 - pow(1 - 1.0 / BLOOM_BLOCK_BITS, (double)i * k), k);
+  }
+  return fpr;
+}
+
+/*
+ * @brief Creates an empty Bloom filter sized for n words.
+ *
+ * @param n	Expected number of words.
+ * @param fpr	Target false-positive rate, 0 < fpr < 1.
+ *
+ * @pre   Memory available.
+ * @post  A filter with all bits cleared is returned.
+ *
+ * @return Pointer to the new filter.
+ */
+Bloom* newBloom(uint32_t n, double fpr) {
+  Bloom* b = malloc(sizeof(Bloom));
+  if (!b) {
+    outOfMemory();
+  }
+
+  // start from the classic sizing, m = -n ln(p) / ln(2)^2 bits, and add
+  // blocks until the blocked filter, with its best k, reaches fpr
+  uint32_t words = n > 0 ? n : 1;
+  double bitsPerWord = -log(fpr) / (M_LN2 * M_LN2);
+  double blocks = ceil(bitsPerWord * words / BLOOM_BLOCK_BITS);
+  b->nBlocks = blocks < UINT32_MAX / 2 ? (uint32_t)blocks : UINT32_MAX / 2;
+  b->fpr = fpr;
+  b->owned = true;
+  for (;;) {
+    double best = 1;
+    for (int k = 1; k <= BLOOM_MAX_K; k++) {
+      double rate = blockedFpr(words, b->nBlocks, k);
+      if (rate < best) {
+        best = rate;
+        b->k = k;
+      }
+    }
+    if (best <= fpr || b->nBlocks >= UINT32_MAX / 2) {
+      break;
+    }
+    b->nBlocks += b->nBlocks / 32 + 1;
+  }
+
+  size_t bytes = (size_t)b->nBlocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+  void* mem;
+  if (posix_memalign(&mem, 64, bytes) != 0) {
+    outOfMemory();
+  }
+  memset(mem, 0, bytes);
+  b->blocks = mem;
+
+  return b;
+}
+
+/*
+ * @brief Hashes a word to 64 bits (FNV-1a followed by a 64-bit mixer).
+ *
+ * @param word	Null-terminated string.
+ *
+ * @return The hash value.
+ */
+uint64_t hashWord(const char* word) {
+  uint64_t h = 14695981039346656037ull;
+  for (int i = 0; word[i] != '\0'; i++) {
+    h ^= (unsigned char)word[i];
+    h *= 1099511628211ull;
+  }
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+/*
+ * @brief Returns the block of the filter that a hash value maps to.
+ *
+ * @param b	Pointer to the filter.
+ * @param h	Hash value from hashWord.
+ *
+ * @return Pointer to the first word of the block.
+ */
+uint64_t* bloomBlock(Bloom* b, uint64_t h) {
+  // multiply-shift maps the high 32 bits onto [0, nBlocks) without a division
+  uint32_t block = (uint32_t)(((h >> 32) * b->nBlocks) >> 32);
+  return b->blocks + (size_t)block * BLOOM_BLOCK_WORDS;
+}
+
+/*
+ * @brief Returns the next bit of a word inside its block.
+ *
+ * Each step multiplies by an odd constant and takes the top 9 bits, so the
+ * k bits of a word are close to independent. Stepping h1 + i * h2 through
+ * the block instead puts them in an arithmetic progression, which shares
+ * bits between words far more often than the sizing in newBloom allows for.
+ *
+ * @param g	Hash state, starting at the value from hashWord.
+ *
+ * @return A bit index below BLOOM_BLOCK_BITS.
+ */
+uint32_t bloomNextBit(uint64_t* g) {
+  *g *= 0x9e3779b97f4a7c15ull;
+  return (uint32_t)(*g >> (64 - 9));  // 2^9 = BLOOM_BLOCK_BITS
+}
+
+/*
+ * @brief Adds a word to the filter.
+ *
+ * @param b	Pointer to the filter.
+ * @param word	Null-terminated clean lowercase word.
+ *
+ * @pre   b != NULL.
+ * @post  bloomMayContain(b, word) returns true.
+ */
+void bloomAdd(Bloom* b, const char* word) {
+  uint64_t h = hashWord(word);
+  uint64_t* block = bloomBlock(b, h);
+  uint64_t g = h;
+
+  for (int i = 0; i < b->k; i++) {
+    uint32_t bit = bloomNextBit(&g);
+    block[bit / 64] |= 1ull << (bit % 64);
+  }
+}
+
+/*
+ * @brief Tests whether a word may be in the filter.
+ *
+ * @param b	Pointer to the filter.
+ * @param word	Null-terminated clean lowercase word.
+ *
+ * @pre   b != NULL.
+ *
+ * @return false if the word was certainly never added, true otherwise.
+ */
+bool bloomMayContain(Bloom* b, const char* word) {
+  uint64_t h = hashWord(word);
+  const uint64_t* block = bloomBlock(b, h);
+  uint64_t g = h;
+
+  for (int i = 0; i < b->k; i++) {
+    uint32_t bit = bloomNextBit(&g);
+    if ((block[bit / 64] & (1ull << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * @brief Frees a Bloom filter.
+ *
+ * @param b	Pointer to the filter (may be NULL).
+ */
+void freeBloom(Bloom* b) {
+  if (!b) {
+    return;
+  }
+
+  if (b->owned) {
+    free(b->blocks);
+  }
+  free(b);
+}
+
 /*
  * ============================================================================
  *                               TRIE IMPLEMENTATION
@@ -52,12 +324,61 @@ struct TrieNode {
   Trie children[26];
 };
 
+/*
+ * @struct DictImageNode
+ * @brief Node of a precompiled dictionary image.
+ *
+ * @var mask		bits 0-25 mark which children exist, bit 31 is endNode.
+ * @var firstChild	index of the first child; the children of a node are
+ * 			stored next to each other in letter order.
+ */
+#define DICT_END_BIT (1u << 31)
+
+typedef struct DictImageNode {
+  uint32_t mask;
+  uint32_t firstChild;
+} DictImageNode;
+
+/*
+ * @struct CheckStats
+ * @brief Counters collected by check().
+ *
+ * @var checked		number of words looked up
+ * @var bloomRejected	lookups answered "unknown" by the Bloom filter alone
+ * @var falsePositives	lookups that passed the Bloom filter but not the Trie
+ * @var timed		true if processWord times each lookup (--stats)
+ * @var seconds		time spent in check() when timed
+ */
+typedef struct CheckStats {
+  uint64_t checked;
+  uint64_t bloomRejected;
+  uint64_t falsePositives;
+  bool timed;
+  double seconds;
+} CheckStats;
+
 /*
  * @struct dict
- * @brief Wrapper containing the root of a Trie.
+ * @brief Wrapper containing the root of a Trie, or a mapped dictionary image.
+ *
+ * @var root		root of the Trie (NULL when an image is mapped)
+ * @var nodes		nodes of the mapped image (NULL when a Trie is used)
+ * @var map		start of the mapping, passed to munmap
+ * @var mapSize		size of the mapping in bytes
+ * @var nodeCount	number of nodes, including the root
+ * @var wordCount	number of distinct words
+ * @var bloom		optional Bloom filter consulted before the Trie (may be NULL)
+ * @var stats		lookup statistics
  */
 typedef struct dict {
   Trie root;
+  const DictImageNode* nodes;
+  void* map;
+  size_t mapSize;
+  uint32_t nodeCount;
+  uint32_t wordCount;
+  Bloom* bloom;
+  CheckStats stats;
 } dict;
 
 /*
@@ -98,22 +419,57 @@ dict* newEmptyDict(void) {
   }
 
   d->root = newTrieNode();
+  d->nodes = NULL;
+  d->map = NULL;
+  d->mapSize = 0;
+  d->nodeCount = 1;
+  d->wordCount = 0;
+  d->bloom = NULL;
+  memset(&d->stats, 0, sizeof(d->stats));
   return d;
 }
 
 /*
- * @brief Checks whether a word exists in the dictionary.
+ * @brief Checks whether a word exists in a precompiled dictionary image.
  *
  * @param word	Null-terminated clean lowercase word.
- * @param d	Pointer to dictionary.
+ * @param nodes	Node array of the image; the root is node 0.
+ *
+ * @pre word is lowercase alphabetic and null-terminated.
+ * @post returns true iff the word is stored in the image.
+ *
+ * @return true if word exists in the image, false otherwise.
+ */
+bool checkImage(const char* word, const DictImageNode* nodes) {
+  DictImageNode node = nodes[0];
+
+  for (int i = 0; word[i] != '\0'; i++) {
+    uint32_t bit = 1u << (word[i] - 'a');
+
+    if ((node.mask & bit) == 0) {
+      return false;
+    }
+
+    // children are stored in letter order, so skip the smaller siblings
+    node = nodes[node.firstChild + __builtin_popcount(node.mask & (bit - 1))];
+  }
+
+  return (node.mask & DICT_END_BIT) != 0;
+}
+
+/*
+ * @brief Checks whether a word exists in a pointer-based Trie.
+ *
+ * @param word	Null-terminated clean lowercase word.
+ * @param root	Root of the Trie.
  *
  * @pre word is lowercase alphabetic and null-terminated.
  * @post returns true iff the word is stored in the Trie.
  *
- * @return true if word exists in dictionary, false otherwise.
+ * @return true if word exists in the Trie, false otherwise.
  */
-bool check(const char* word, dict* d) {
-  Trie node = d->root;
+bool checkTrie(const char* word, Trie root) {
+  Trie node = root;
 
   for (int i = 0; word[i] != '\0'; i++) {
     int idx = word[i] - 'a';
@@ -128,6 +484,36 @@ bool check(const char* word, dict* d) {
   return node->endNode;
 }
 
+/*
+ * @brief Checks whether a word exists in the dictionary.
+ * If the dictionary has a Bloom filter, it is consulted first and a negative
+ * answer is returned without walking the Trie.
+ *
+ * @param word	Null-terminated clean lowercase word.
+ * @param d	Pointer to dictionary.
+ *
+ * @pre word is lowercase alphabetic and null-terminated.
+ * @post returns true iff the word is stored in the dictionary; d->stats is updated.
+ *
+ * @return true if word exists in dictionary, false otherwise.
+ */
+bool check(const char* word, dict* d) {
+  d->stats.checked++;
+
+  if (d->bloom != NULL && !bloomMayContain(d->bloom, word)) {
+    d->stats.bloomRejected++;
+    return false;
+  }
+
+  bool known = d->nodes != NULL ? checkImage(word, d->nodes) : checkTrie(word, d->root);
+
+  if (d->bloom != NULL && !known) {
+    d->stats.falsePositives++;
+  }
+
+  return known;
+}
+
 /*
  * @brief Inserts a cleaned, lowercase word into the Trie.
  *
@@ -144,11 +530,15 @@ void addWord(char word[LENGTH + 1], dict* d) {
 
     if (node->children[idx] == NULL) {
       node->children[idx] = newTrieNode();
+      d->nodeCount++;
     }
 
     node = node->children[idx];
   }
 
+  if (!node->endNode) {
+    d->wordCount++;
+  }
   node->endNode = true;
 }
 
@@ -186,9 +576,54 @@ void freeDict(dict* d) {
   }
 
   freeTrie(d->root);
+  freeBloom(d->bloom);
+  if (d->map != NULL) {
+    munmap(d->map, d->mapSize);
+  }
   free(d);
 }
 
+/*
+ * @brief Recursively adds every word below a Trie node to a Bloom filter.
+ *
+ * @param node	Current Trie node.
+ * @param word	Buffer holding the letters on the path to node.
+ * @param depth	Number of letters in word.
+ * @param b	Pointer to the filter.
+ */
+void addTrieToBloom(Trie node, char word[LENGTH + 1], int depth, Bloom* b) {
+  if (node->endNode) {
+    word[depth] = '\0';
+    bloomAdd(b, word);
+  }
+
+  for (int i = 0; i < 26 && depth < LENGTH; i++) {
+    if (node->children[i] != NULL) {
+      word[depth] = 'a' + i;
+      addTrieToBloom(node->children[i], word, depth + 1, b);
+    }
+  }
+}
+
+/*
+ * @brief Builds a Bloom filter over all words of the dictionary and
+ * makes check() consult it before the Trie.
+ *
+ * @param d	Pointer to dictionary.
+ * @param fpr	Target false-positive rate, 0 < fpr < 1.
+ *
+ * @pre   All words have been added to d, which holds a Trie; a mapped
+ *        image brings its filter along (see mapDict).
+ * @post  d->bloom contains every word of d.
+ */
+void enableBloom(dict* d, double fpr) {
+  char word[LENGTH + 1];
+
+  freeBloom(d->bloom);
+  d->bloom = newBloom(d->wordCount, fpr);
+  addTrieToBloom(d->root, word, 0, d->bloom);
+}
+
 /*
  * @brief Cleans a dictionary word:
  * 		- removes all non-letter characters
@@ -211,133 +646,1146 @@ void trimWord(char* word) {
   word[k] = '\0';
 }
 
+/*
+ * @brief Reads dictionary words from stdin until the '%' symbol and adds them to d.
+ *
+ * @param d	Pointer to dictionary.
+ *
+ * @pre   d was created with newEmptyDict.
+ * @post  All words before the '%' symbol (or EOF) are cleaned and added to d.
+ */
+void readDictionary(dict* d) {
+  char buffer[LENGTH + 1];  // Temporary string used to read dictionary words.
+
+  // Read words until '%' appears
+  while (scanf("%45s", buffer) == 1) {
+    if (strchr(buffer, '%') != NULL) {
+      break;  // stop when encountering %
+    }
+
+    trimWord(buffer);
+    if (buffer[0] != '\0') {
+      addWord(buffer, d);
+    }
+  }
+}
+
 /* ============================================================================
- *                 DYNAMIC LIST FOR STORING UNKNOWN WORDS
+ *                       PRECOMPILED DICTIONARY IMAGE
  * ============================================================================
+ *
+ * File layout: a DictImageHeader followed by nodeCount DictImageNodes.
+ * Nodes are numbered in breadth-first order with the root at index 0, so
+ * all children of a node are adjacent and only the index of the first one
+ * is stored. All links are indices, which makes the image position
+ * independent and usable straight from an mmap. If the dictionary had a
+ * Bloom filter, its blocks follow at the next multiple of 64 bytes, so
+ * they stay cache-line aligned in the mapping.
  */
 
+#define DICT_MAGIC "SPDICT02"
+
 /*
- * @struct UnknownList
- * @brief Dynamic list of unknown words discovered in the text.
+ * @struct DictImageHeader
+ * @brief Header at the start of a dictionary image file.
  *
- * @var words		dynamic array of strings
- * @var size		number of unknown words stored
- * @var capacity	allocated capacity of the array
+ * @var magic		DICT_MAGIC, identifies the file format and version
+ * @var nodeCount	number of nodes following the header
+ * @var wordCount	number of distinct words in the dictionary
+ * @var bloomBlocks	number of Bloom filter blocks, 0 without a filter
+ * @var bloomK		number of bits set per word in the filter
+ * @var bloomFpr	false-positive rate the filter was sized for
  */
-typedef struct UnknownList {
-  char** words;  // dynamic array of C strings
-  int size;      // number of unknown words stored
-  int capacity;  // allocated capacity
-} UnknownList;
+typedef struct DictImageHeader {
+  char magic[8];
+  uint32_t nodeCount;
+  uint32_t wordCount;
+  uint32_t bloomBlocks;
+  uint32_t bloomK;
+  double bloomFpr;
+} DictImageHeader;
 
-/**
- * @brief Creates an empty UnknownList.
+/*
+ * @brief Returns where the Bloom filter of an image starts.
+ *
+ * @param nodeCount	Number of nodes in the image.
+ *
+ * @return Offset in bytes from the start of the file, a multiple of 64.
+ */
+uint64_t bloomOffset(uint32_t nodeCount) {
+  uint64_t end = sizeof(DictImageHeader) + (uint64_t)nodeCount * sizeof(DictImageNode);
+  return (end + 63) / 64 * 64;
+}
+
+/*
+ * @brief Writes the Trie of a dictionary to a file as a flat image.
+ *
+ * @param d	Pointer to a dictionary built with addWord.
+ * @param path	Name of the file to create.
  *
- * @pre   Memory available
- * @post  UnknownList with capacity=1000 and size=0 is created.
+ * @pre   d->root != NULL.
+ * @post  path contains an image that mapDict accepts, with the Bloom
+ *        filter of d if it has one.
  *
- * @return Pointer to the newly created UnknownList.
+ * @return true on success, false if the file could not be written.
  */
-UnknownList* newUnknownList(void) {
-  UnknownList* u = malloc(sizeof(UnknownList));
-  if (!u) {
-    exit(1);
+bool compileDict(dict* d, const char* path) {
+  // BFS order: queue[i] is the Trie node that becomes image node i
+  Trie* queue = malloc(d->nodeCount * sizeof(Trie));
+  DictImageNode* nodes = malloc(d->nodeCount * sizeof(DictImageNode));
+  if (!queue || !nodes) {
+    outOfMemory();
   }
 
-  u->capacity = 1000;
-  u->size = 0;
-  u->words = malloc(u->capacity * sizeof(char*));
+  uint32_t tail = 0;
+  queue[tail++] = d->root;
+  for (uint32_t head = 0; head < tail; head++) {
+    Trie node = queue[head];
+    nodes[head].mask = node->endNode ? DICT_END_BIT : 0;
+    nodes[head].firstChild = tail;
 
-  if (!u->words) {
-    exit(1);
+    for (int i = 0; i < 26; i++) {
+      if (node->children[i] != NULL) {
+        nodes[head].mask |= 1u << i;
+        queue[tail++] = node->children[i];
+      }
+    }
+  }
+
+  DictImageHeader header;
+  memcpy(header.magic, DICT_MAGIC, sizeof(header.magic));
+  header.nodeCount = d->nodeCount;
+  header.wordCount = d->wordCount;
+  header.bloomBlocks = d->bloom != NULL ? d->bloom->nBlocks : 0;
+  header.bloomK = d->bloom != NULL ? d->bloom->k : 0;
+  header.bloomFpr = d->bloom != NULL ? d->bloom->fpr : 0;
+
+  FILE* f = fopen(path, "wb");
+  bool ok = f != NULL &&
+            fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(nodes, sizeof(DictImageNode), d->nodeCount, f) == d->nodeCount;
+  if (ok && d->bloom != NULL) {
+    static const char padding[64];
+    size_t pad = bloomOffset(d->nodeCount) - sizeof(header) - (size_t)d->nodeCount * sizeof(DictImageNode);
+    size_t words = (size_t)d->bloom->nBlocks * BLOOM_BLOCK_WORDS;
+    ok = fwrite(padding, 1, pad, f) == pad && fwrite(d->bloom->blocks, sizeof(uint64_t), words, f) == words;
+  }
+  if (f != NULL && fclose(f) != 0) {
+    ok = false;
   }
 
-  return u;
+  free(queue);
+  free(nodes);
+  return ok;
 }
 
-/**
- * @brief Adds a newly found unknown word to the dynamic list, resizing as needed.
+/*
+ * @brief Checks that every link of an image stays inside it.
  *
- * @param u	Pointer to UnknownList.
- * @param word	Null-terminated string containing the unknown word.
+ * @param nodes	Nodes of the image.
+ * @param count	Number of nodes.
  *
- * @pre		word is not NULL.
- * @post	word is copied and appended, capacity might be increased.
+ * @pre   None.
+ * @post  None.
+ *
+ * @return true if only mask bits 0-25 and 31 are used and the children of
+ *         every node lie after it and below count, false otherwise.
  */
-void addUnknown(UnknownList* u, const char* word) {
-  if (u->size == u->capacity) {
-    u->capacity *= 2;
-    u->words = realloc(u->words, u->capacity * sizeof(char*));
-
-    if (!u->words) {
-      exit(1);
+bool validImage(const DictImageNode* nodes, uint32_t count) {
+  for (uint32_t n = 0; n < count; n++) {
+    uint32_t letters = nodes[n].mask & ~DICT_END_BIT;
+    if (letters >> 26 != 0) {
+      return false;
+    }
+    // children after their parent also rules out cycles
+    if (letters != 0 &&
+        (nodes[n].firstChild <= n || (uint64_t)nodes[n].firstChild + __builtin_popcount(letters) > count)) {
+      return false;
     }
   }
-
-  u->words[u->size] = malloc(strlen(word) + 1);
-  strcpy(u->words[u->size], word);
-  u->size++;
+  return true;
 }
 
-/**
- * @brief Frees all memory used by the unknown-word list.
+/*
+ * @brief Maps a dictionary image created by compileDict.
+ *
+ * @param path	Name of the image file.
  *
- * @param u	Pointer to the UnknownList to be removed
+ * @pre   None.
+ * @post  The image is mapped read-only and must be released with freeDict.
+ *        A Bloom filter stored in the image is used straight from the
+ *        mapping.
  *
- * @pre   	u is not NULL.
- * @post  	All stored words and the list are freed.
+ * @return Pointer to a dictionary that queries the image, or NULL if the
+ *         file cannot be opened or is not a valid image.
  */
-void freeUnknownList(UnknownList* u) {
-  if (!u) {
-    return;
+dict* mapDict(const char* path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(DictImageHeader)) {
+    close(fd);
+    return NULL;
+  }
+
+  size_t size = st.st_size;
+  void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return NULL;
   }
 
-  for (int i = 0; i < u->size; i++) {
-    free(u->words[i]);
+  const DictImageHeader* header = map;
+  if (memcmp(header->magic, DICT_MAGIC, sizeof(header->magic)) != 0 ||
+      header->nodeCount == 0 ||
+      (size - sizeof(DictImageHeader)) / sizeof(DictImageNode) < header->nodeCount ||
+      !validImage((const DictImageNode*)(header + 1), header->nodeCount) ||
+      (header->bloomBlocks > 0 &&
+       (header->bloomK < 1 || header->bloomK > BLOOM_MAX_K ||
+        size < bloomOffset(header->nodeCount) ||
+        (size - bloomOffset(header->nodeCount)) / (BLOOM_BLOCK_WORDS * sizeof(uint64_t)) < header->bloomBlocks))) {
+    munmap(map, size);
+    return NULL;
   }
 
-  free(u->words);
-  free(u);
+  dict* d = malloc(sizeof(dict));
+  if (d == NULL) {
+    outOfMemory();
+  }
+
+  d->root = NULL;
+  d->nodes = (const DictImageNode*)(header + 1);
+  d->map = map;
+  d->mapSize = size;
+  d->nodeCount = header->nodeCount;
+  d->wordCount = header->wordCount;
+  d->bloom = NULL;
+  memset(&d->stats, 0, sizeof(d->stats));
+
+  if (header->bloomBlocks > 0) {
+    d->bloom = malloc(sizeof(Bloom));
+    if (d->bloom == NULL) {
+      outOfMemory();
+    }
+    d->bloom->blocks = (uint64_t*)((char*)map + bloomOffset(header->nodeCount));
+    d->bloom->nBlocks = header->bloomBlocks;
+    d->bloom->k = header->bloomK;
+    d->bloom->fpr = header->bloomFpr;
+    d->bloom->owned = false;
+  }
+  return d;
 }
 
 /* ============================================================================
- *                                   MAIN
+ *                        STRING ARENA AND WORD TABLE
  * ============================================================================
  */
 
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
 /*
- * @brief Main program: builds dictionary, processes text, outputs unknown words.
+ * @struct ArenaBlock
+ * @brief One block of an Arena; strings are carved from data.
+ */
+typedef struct ArenaBlock {
+  struct ArenaBlock* next;
+  size_t used;
+  size_t size;
+  char data[];
+} ArenaBlock;
+
+/*
+ * @struct Arena
+ * @brief Bump allocator for strings that live as long as the arena.
+ * Strings cannot be freed one by one; freeArena releases all blocks at once.
+ */
+typedef struct Arena {
+  ArenaBlock* head;
+} Arena;
+
+/*
+ * @brief Copies a string into the arena.
  *
- * @pre   Input must follow format:
- * 		<dictionary words separated by non-alphabetic characters>
- * 		%
- * 		<text>
- * @post  Unknown words are printed and then their count.
+ * @param a	Pointer to the arena.
+ * @param s	Null-terminated string.
  *
- * @return exit (0) on success.
+ * @return Pointer to the copy, valid until freeArena(a).
  */
-int main(void) {
-  // Step 1: read in the dictionary
-  char buffer[LENGTH + 1];            // Temporary string used to read dictionary words.
-  dict* dictionary = newEmptyDict();  // Trie storing all valid dictionary words.
-
-  // Read words until '%' appears
-  while (scanf("%45s", buffer) == 1) {
-    if (strchr(buffer, '%') != NULL) {
-      break;  // stop when encountering %
-    }
+char* arenaStrdup(Arena* a, const char* s) {
+  size_t len = strlen(s) + 1;
 
-    trimWord(buffer);
-    if (buffer[0] != '\0') {
-      addWord(buffer, dictionary);
+  if (a->head == NULL || a->head->size - a->head->used < len) {
+    size_t size = len > ARENA_BLOCK_SIZE ? len : ARENA_BLOCK_SIZE;
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (!block) {
+      outOfMemory();
     }
+    block->next = a->head;
+    block->used = 0;
+    block->size = size;
+    a->head = block;
   }
 
-  // Step 2: read in text
-  UnknownList* unknown = newUnknownList();
+  char* copy = a->head->data + a->head->used;
+  memcpy(copy, s, len);
+  a->head->used += len;
+  return copy;
+}
+
+/*
+ * @brief Frees all blocks of the arena.
+ *
+ * @param a	Pointer to the arena.
+ *
+ * @post  Every string returned by arenaStrdup(a, ...) is invalid; a is empty.
+ */
+void freeArena(Arena* a) {
+  while (a->head != NULL) {
+    ArenaBlock* next = a->head->next;
+    free(a->head);
+    a->head = next;
+  }
+}
+
+/*
+ * @struct WordEntry
+ * @brief Distinct word stored in a WordTable.
+ *
+ * @var word	the word, stored in the table's arena
+ * @var hash	hashWord(word)
+ * @var count	number of times the word was counted
+ * @var first	position of the first occurrence
+ */
+typedef struct WordEntry {
+  const char* word;
+  uint64_t hash;
+  uint64_t count;
+  uint64_t first;
+} WordEntry;
+
+/*
+ * @struct WordTable
+ * @brief Hash table of distinct words that remembers insertion order.
+ *
+ * @var arena		storage for the words
+ * @var entries		entries in insertion order
+ * @var size		number of entries
+ * @var entryCapacity	allocated length of entries
+ * @var slots		open-addressing index: entry index + 1, or 0 if empty
+ * @var capacity	number of slots, a power of two
+ */
+typedef struct WordTable {
+  Arena arena;
+  WordEntry* entries;
+  size_t size;
+  size_t entryCapacity;
+  uint32_t* slots;
+  size_t capacity;
+} WordTable;
+
+/*
+ * @brief Creates an empty WordTable.
+ *
+ * @return Pointer to the new table.
+ */
+WordTable* newWordTable(void) {
+  WordTable* t = malloc(sizeof(WordTable));
+  if (!t) {
+    outOfMemory();
+  }
+
+  t->arena.head = NULL;
+  t->size = 0;
+  t->entryCapacity = 64;
+  t->entries = malloc(t->entryCapacity * sizeof(WordEntry));
+  t->capacity = 128;
+  t->slots = calloc(t->capacity, sizeof(uint32_t));
+  if (!t->entries || !t->slots) {
+    outOfMemory();
+  }
+
+  return t;
+}
+
+/*
+ * @brief Doubles the number of slots and rebuilds the index.
+ */
+void growWordTable(WordTable* t) {
+  free(t->slots);
+  t->capacity *= 2;
+  t->slots = calloc(t->capacity, sizeof(uint32_t));
+  if (!t->slots) {
+    outOfMemory();
+  }
+
+  size_t mask = t->capacity - 1;
+  for (size_t e = 0; e < t->size; e++) {
+    size_t i = t->entries[e].hash & mask;
+    while (t->slots[i] != 0) {
+      i = (i + 1) & mask;
+    }
+    t->slots[i] = e + 1;
+  }
+}
+
+/*
+ * @brief Finds a word in the table, inserting it if it is not there yet.
+ *
+ * @param t	Pointer to the table.
+ * @param word	Null-terminated string.
+ * @param added	Set to true if the word was inserted, false if it was found.
+ *
+ * @post  A new entry has count = 0 and first = 0.
+ *
+ * @return Index of the word's entry in t->entries.
+ */
+size_t wordTableAdd(WordTable* t, const char* word, bool* added) {
+  uint64_t h = hashWord(word);
+  size_t mask = t->capacity - 1;
+  size_t i = h & mask;
+
+  while (t->slots[i] != 0) {
+    WordEntry* e = &t->entries[t->slots[i] - 1];
+    if (e->hash == h && strcmp(e->word, word) == 0) {
+      *added = false;
+      return t->slots[i] - 1;
+    }
+    i = (i + 1) & mask;
+  }
+
+  if (t->size == t->entryCapacity) {
+    t->entryCapacity *= 2;
+    t->entries = realloc(t->entries, t->entryCapacity * sizeof(WordEntry));
+    if (!t->entries) {
+      outOfMemory();
+    }
+  }
+
+  size_t index = t->size++;
+  t->entries[index].word = arenaStrdup(&t->arena, word);
+  t->entries[index].hash = h;
+  t->entries[index].count = 0;
+  t->entries[index].first = 0;
+  t->slots[i] = index + 1;
+
+  if (2 * t->size > t->capacity) {
+    growWordTable(t);
+  }
+
+  *added = true;
+  return index;
+}
+
+/*
+ * @brief Frees the table and all its words.
+ *
+ * @param t	Pointer to the table (may be NULL).
+ */
+void freeWordTable(WordTable* t) {
+  if (!t) {
+    return;
+  }
+
+  freeArena(&t->arena);
+  free(t->entries);
+  free(t->slots);
+  free(t);
+}
+
+/* ============================================================================
+ *                         CORRECTION SUGGESTIONS
+ * ============================================================================
+ *
+ * Suggestions are found by walking the dictionary once per unknown word
+ * while computing one row of the Levenshtein DP table per Trie level:
+ * row[i] is the edit distance between the current prefix and the first i
+ * letters of the word. A subtree is skipped as soon as the smallest value
+ * in its row exceeds the allowed distance, since every extension of the
+ * prefix is at least that far away.
+ */
+
+/*
+ * @struct Suggestion
+ * @brief A dictionary word and its edit distance to the unknown word.
+ */
+typedef struct Suggestion {
+  char word[LENGTH + 1];
+  int dist;
+} Suggestion;
+
+/*
+ * @struct SuggestSearch
+ * @brief State of one suggestion search.
+ *
+ * @var word		the unknown word
+ * @var len		length of word
+ * @var maxDist		largest edit distance to report
+ * @var k		number of suggestions wanted
+ * @var count		number of suggestions found so far (<= k)
+ * @var best		found suggestions, sorted by distance, then alphabetically
+ * @var prefix		letters on the path from the root to the current node
+ * @var rows		rows[depth] is the DP row for prefix[0..depth)
+ */
+typedef struct SuggestSearch {
+  const char* word;
+  int len;
+  int maxDist;
+  int k;
+  int count;
+  Suggestion* best;
+  char prefix[LENGTH + 1];
+  int rows[LENGTH + 1][LENGTH + 1];
+} SuggestSearch;
+
+/*
+ * @brief Returns the largest distance still worth exploring.
+ * The Trie is walked in alphabetical order, so once k suggestions are found
+ * a later word only gets in if it is strictly closer than the worst one.
+ */
+int suggestBound(SuggestSearch* s) {
+  if (s->count == s->k) {
+    return s->best[s->k - 1].dist - 1;
+  }
+  return s->maxDist;
+}
+
+/*
+ * @brief Computes the DP row for prefix[0..depth) after appending letter c.
+ *
+ * @param s	Search state; rows[depth - 1] must be filled in.
+ * @param depth	Length of the new prefix (>= 1).
+ * @param c	Last letter of the new prefix.
+ *
+ * @return The smallest value in the new row.
+ */
+int suggestRow(SuggestSearch* s, int depth, char c) {
+  const int* prev = s->rows[depth - 1];
+  int* row = s->rows[depth];
+  int rowMin = row[0] = depth;
+
+  for (int i = 1; i <= s->len; i++) {
+    int best = prev[i - 1] + (s->word[i - 1] != c);  // substitute or match
+    if (prev[i] + 1 < best) {
+      best = prev[i] + 1;  // insert c
+    }
+    if (row[i - 1] + 1 < best) {
+      best = row[i - 1] + 1;  // delete word[i - 1]
+    }
+    row[i] = best;
+    if (best < rowMin) {
+      rowMin = best;
+    }
+  }
+
+  return rowMin;
+}
+
+/*
+ * @brief Inserts prefix[0..depth) with distance dist into the sorted top-k.
+ *
+ * @pre dist <= suggestBound(s).
+ */
+void suggestAdd(SuggestSearch* s, int depth, int dist) {
+  int pos = s->count < s->k ? s->count++ : s->k - 1;
+
+  // words arrive in alphabetical order, so equal distances keep their order
+  while (pos > 0 && s->best[pos - 1].dist > dist) {
+    s->best[pos] = s->best[pos - 1];
+    pos--;
+  }
+
+  memcpy(s->best[pos].word, s->prefix, depth);
+  s->best[pos].word[depth] = '\0';
+  s->best[pos].dist = dist;
+}
+
+/*
+ * @brief Explores the children of a Trie node at the given depth.
+ */
+void suggestTrie(SuggestSearch* s, Trie node, int depth) {
+  for (int i = 0; i < 26 && depth < LENGTH; i++) {
+    Trie child = node->children[i];
+    if (child == NULL) {
+      continue;
+    }
+
+    s->prefix[depth] = 'a' + i;
+    int rowMin = suggestRow(s, depth + 1, 'a' + i);
+
+    if (child->endNode && s->rows[depth + 1][s->len] <= suggestBound(s)) {
+      suggestAdd(s, depth + 1, s->rows[depth + 1][s->len]);
+    }
+    if (rowMin <= suggestBound(s)) {
+      suggestTrie(s, child, depth + 1);
+    }
+  }
+}
+
+/*
+ * @brief Explores the children of image node n at the given depth.
+ */
+void suggestImage(SuggestSearch* s, const DictImageNode* nodes, uint32_t n, int depth) {
+  uint32_t child = nodes[n].firstChild;
+
+  for (int i = 0; i < 26 && depth < LENGTH; i++) {
+    if ((nodes[n].mask & (1u << i)) == 0) {
+      continue;
+    }
+
+    s->prefix[depth] = 'a' + i;
+    int rowMin = suggestRow(s, depth + 1, 'a' + i);
+
+    if ((nodes[child].mask & DICT_END_BIT) && s->rows[depth + 1][s->len] <= suggestBound(s)) {
+      suggestAdd(s, depth + 1, s->rows[depth + 1][s->len]);
+    }
+    if (rowMin <= suggestBound(s)) {
+      suggestImage(s, nodes, child, depth + 1);
+    }
+    child++;
+  }
+}
+
+/*
+ * @brief Finds the k dictionary words closest to word in edit distance.
+ *
+ * @param d		Pointer to dictionary.
+ * @param word		Null-terminated clean lowercase word.
+ * @param maxDist	Largest edit distance to report.
+ * @param k		Maximum number of suggestions.
+ * @param out		Array of at least k suggestions.
+ *
+ * @pre   word has at most LENGTH letters.
+ * @post  out[0..result) holds the suggestions, closest first and
+ *        alphabetically among equal distances.
+ *
+ * @return Number of suggestions found.
+ */
+int suggest(dict* d, const char* word, int maxDist, int k, Suggestion* out) {
+  SuggestSearch* s = malloc(sizeof(SuggestSearch));
+  if (!s) {
+    outOfMemory();
+  }
+
+  s->word = word;
+  s->len = strlen(word);
+  s->maxDist = maxDist;
+  s->k = k;
+  s->count = 0;
+  s->best = out;
+  for (int i = 0; i <= s->len; i++) {
+    s->rows[0][i] = i;
+  }
+
+  if (d->nodes != NULL) {
+    suggestImage(s, d->nodes, 0, 0);
+  } else {
+    suggestTrie(s, d->root, 0);
+  }
+
+  int count = s->count;
+  free(s);
+  return count;
+}
+
+/*
+ * @struct SuggestCache
+ * @brief Cache from unknown words to their formatted suggestion lists, so
+ * repeated misspellings are only searched once.
+ *
+ * @var words		distinct words looked up so far
+ * @var values		values[i] holds the suggestions for words->entries[i]
+ * @var valueCapacity	allocated length of values
+ * @var hits		lookups answered from the cache
+ * @var latencies	seconds spent on each search (cache misses)
+ * @var latencyCount	number of entries in latencies
+ * @var latencyCapacity	allocated length of latencies
+ */
+typedef struct SuggestCache {
+  WordTable* words;
+  const char** values;
+  size_t valueCapacity;
+  uint64_t hits;
+  double* latencies;
+  size_t latencyCount;
+  size_t latencyCapacity;
+} SuggestCache;
+
+/*
+ * @brief Creates an empty suggestion cache.
+ *
+ * @return Pointer to the new cache.
+ */
+SuggestCache* newSuggestCache(void) {
+  SuggestCache* c = malloc(sizeof(SuggestCache));
+  if (!c) {
+    outOfMemory();
+  }
+
+  c->words = newWordTable();
+  c->valueCapacity = 64;
+  c->values = malloc(c->valueCapacity * sizeof(char*));
+  c->hits = 0;
+  c->latencyCapacity = 64;
+  c->latencyCount = 0;
+  c->latencies = malloc(c->latencyCapacity * sizeof(double));
+  if (!c->values || !c->latencies) {
+    outOfMemory();
+  }
+
+  return c;
+}
+
+/*
+ * @brief Returns the suggestions for an unknown word as "a, b, c",
+ * searching the dictionary only the first time the word is seen.
+ *
+ * @param c		Pointer to the cache.
+ * @param d		Pointer to dictionary.
+ * @param word		Null-terminated clean lowercase word.
+ * @param maxDist	Largest edit distance to report.
+ * @param k		Maximum number of suggestions.
+ *
+ * @return The formatted suggestions; owned by the cache.
+ */
+const char* lookupSuggestions(SuggestCache* c, dict* d, const char* word, int maxDist, int k) {
+  bool added;
+  size_t i = wordTableAdd(c->words, word, &added);
+  if (!added) {
+    c->hits++;
+    return c->values[i];
+  }
+
+  double start = now();
+  Suggestion* best = malloc((size_t)k * sizeof(Suggestion));
+  char* text = malloc((size_t)k * (LENGTH + 2) + 1);  // k words and their ", "
+  if (!best || !text) {
+    outOfMemory();
+  }
+
+  int count = suggest(d, word, maxDist, k, best);
+  text[0] = '\0';
+  for (int j = 0; j < count; j++) {
+    if (j > 0) {
+      strcat(text, ", ");
+    }
+    strcat(text, best[j].word);
+  }
+
+  if (i == c->valueCapacity) {
+    c->valueCapacity *= 2;
+    c->values = realloc(c->values, c->valueCapacity * sizeof(char*));
+    if (!c->values) {
+      outOfMemory();
+    }
+  }
+  c->values[i] = arenaStrdup(&c->words->arena, text);
+  free(best);
+  free(text);
+
+  if (c->latencyCount == c->latencyCapacity) {
+    c->latencyCapacity *= 2;
+    c->latencies = realloc(c->latencies, c->latencyCapacity * sizeof(double));
+    if (!c->latencies) {
+      outOfMemory();
+    }
+  }
+  c->latencies[c->latencyCount++] = now() - start;
+
+  return c->values[i];
+}
+
+/*
+ * @brief Comparison function for sorting latencies with qsort.
+ */
+int compareDoubles(const void* a, const void* b) {
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * @brief Prints cache hit rate and search latency percentiles to stderr.
+ *
+ * @param c	Pointer to the cache.
+ */
+void printSuggestStats(SuggestCache* c) {
+  size_t n = c->latencyCount;
+
+  fprintf(stderr, "suggest:    %zu searches, %" PRIu64 " cache hits\n", n, c->hits);
+  if (n == 0) {
+    return;
+  }
+
+  qsort(c->latencies, n, sizeof(double), compareDoubles);
+  fprintf(stderr, "suggest:    latency p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+          c->latencies[n / 2] * 1e3, c->latencies[(n * 99) / 100] * 1e3, c->latencies[n - 1] * 1e3);
+}
+
+/*
+ * @brief Frees the cache and all stored words and suggestions.
+ *
+ * @param c	Pointer to the cache (may be NULL).
+ */
+void freeSuggestCache(SuggestCache* c) {
+  if (!c) {
+    return;
+  }
+
+  freeWordTable(c->words);
+  free(c->values);
+  free(c->latencies);
+  free(c);
+}
+
+/* ============================================================================
+ *                          UNKNOWN WORD REPORT
+ * ============================================================================
+ */
+
+/*
+ * @struct Report
+ * @brief Collects the unknown words of the text and prints them.
+ *
+ * By default every occurrence is printed as soon as it is found, so memory
+ * use does not grow with the text. In aggregate mode the distinct words are
+ * counted in a WordTable and printed at the end in first-seen order. When
+ * the text itself is echoed (enableColor) the per-occurrence list is held
+ * back as a sequence of WordTable indices and printed after the text.
+ *
+ * @var aggregate	print distinct words with counts instead of every occurrence
+ * @var deferred	hold the per-occurrence output until finishReport
+ * @var words		distinct unknown words (NULL when streaming)
+ * @var order		entry index of every occurrence (deferred mode only)
+ * @var orderSize	number of entries in order
+ * @var orderCapacity	allocated length of order
+ * @var total		number of unknown occurrences
+ * @var cache		suggestion cache (NULL when suggestions are off)
+ * @var d		dictionary used for suggestions
+ * @var maxDist		largest edit distance of a suggestion
+ * @var k		number of suggestions per word
+ */
+typedef struct Report {
+  bool aggregate;
+  bool deferred;
+  WordTable* words;
+  uint32_t* order;
+  size_t orderSize;
+  size_t orderCapacity;
+  uint64_t total;
+  SuggestCache* cache;
+  dict* d;
+  int maxDist;
+  int k;
+} Report;
+
+/**
+ * @brief Creates an empty report.
+ *
+ * @param aggregate	true to print distinct words with counts.
+ * @param deferred	true to print the per-occurrence list only at the end.
+ * @param d		Pointer to dictionary (used for suggestions).
+ * @param k		Number of suggestions per word, 0 for none.
+ * @param maxDist	Largest edit distance of a suggestion.
+ *
+ * @return Pointer to the new report.
+ */
+Report* newReport(bool aggregate, bool deferred, dict* d, int k, int maxDist) {
+  Report* r = malloc(sizeof(Report));
+  if (!r) {
+    outOfMemory();
+  }
+
+  r->aggregate = aggregate;
+  r->deferred = deferred && !aggregate;
+  r->words = (r->aggregate || r->deferred) ? newWordTable() : NULL;
+  r->order = NULL;
+  r->orderSize = 0;
+  r->orderCapacity = 0;
+  r->total = 0;
+  r->cache = k > 0 ? newSuggestCache() : NULL;
+  r->d = d;
+  r->maxDist = maxDist;
+  r->k = k;
+  return r;
+}
+
+/**
+ * @brief Prints the suggestions for word (if enabled) and ends the line.
+ */
+void printSuggestionsLine(Report* r, const char* word) {
+  if (r->cache != NULL) {
+    const char* corrections = lookupSuggestions(r->cache, r->d, word, r->maxDist, r->k);
+    printf(":%s%s", corrections[0] != '\0' ? " " : "", corrections);
+  }
+  printf("\n");
+}
+
+/**
+ * @brief Records one occurrence of an unknown word.
+ *
+ * @param r	Pointer to the report.
+ * @param word	Null-terminated unknown word.
+ * @param pos	Position of the word in the text (1 for the first word).
+ *
+ * @post  In streaming mode the word is printed immediately.
+ */
+void reportUnknown(Report* r, const char* word, uint64_t pos) {
+  r->total++;
+
+  if (r->words == NULL) {
+    printf("%s", word);
+    printSuggestionsLine(r, word);
+    return;
+  }
+
+  bool added;
+  size_t i = wordTableAdd(r->words, word, &added);
+  if (added) {
+    r->words->entries[i].first = pos;
+  }
+  r->words->entries[i].count++;
+
+  if (r->deferred) {
+    if (r->orderSize == r->orderCapacity) {
+      r->orderCapacity = r->orderCapacity ? 2 * r->orderCapacity : 1024;
+      r->order = realloc(r->order, r->orderCapacity * sizeof(uint32_t));
+      if (!r->order) {
+        outOfMemory();
+      }
+    }
+    r->order[r->orderSize++] = i;
+  }
+}
+
+/**
+ * @brief Prints everything that was held back, followed by the number of
+ * unknown occurrences.
+ *
+ * @param r	Pointer to the report.
+ */
+void finishReport(Report* r) {
+  if (r->aggregate) {
+    for (size_t i = 0; i < r->words->size; i++) {
+      WordEntry* e = &r->words->entries[i];
+      printf("%s %" PRIu64 " %" PRIu64, e->word, e->count, e->first);
+      printSuggestionsLine(r, e->word);
+    }
+  } else if (r->deferred) {
+    for (size_t i = 0; i < r->orderSize; i++) {
+      const char* word = r->words->entries[r->order[i]].word;
+      printf("%s", word);
+      printSuggestionsLine(r, word);
+    }
+  }
+
+  printf("%" PRIu64 "\n", r->total);  // Print number of unknown words
+}
+
+/**
+ * @brief Frees the report.
+ *
+ * @param r	Pointer to the report (may be NULL).
+ */
+void freeReport(Report* r) {
+  if (!r) {
+    return;
+  }
+
+  freeWordTable(r->words);
+  freeSuggestCache(r->cache);
+  free(r->order);
+  free(r);
+}
 
-  char word[LENGTH + 1];  // Dynamic structure storing all unknown words.
-  int index = 0;          // Currently accumulated word taken from the input text.
+/*
+ * @brief Checks one word of the text and reports it if it is unknown.
+ *
+ * @param word	Null-terminated clean lowercase word.
+ * @param d	Pointer to dictionary.
+ * @param r	Pointer to the report.
+ * @param pos	Position of the word in the text (1 for the first word).
+ */
+void processWord(const char* word, dict* d, Report* r, uint64_t pos) {
+  double start = d->stats.timed ? now() : 0;
+  bool known = check(word, d);  // True if the word exists in the dictionary.
+  if (d->stats.timed) {
+    d->stats.seconds += now() - start;
+  }
+
+  // BONUS: inline full-text colored output
+  if (enableColor) {
+    if (known) {
+      printf("%s", word);
+    } else {
+      printf("\033[31m%s\033[0m", word);
+    }
+  }
+
+  if (!known) {
+    reportUnknown(r, word, pos);
+  }
+}
+
+/* ============================================================================
+ *                                   MAIN
+ * ============================================================================
+ */
+
+/*
+ * @brief Prints the command line options to stderr.
+ *
+ * @param prog	Name of the program (argv[0]).
+ */
+void usage(const char* prog) {
+  fprintf(stderr, "usage: %s [--compile-dict FILE | --dict FILE] [--bloom FPR] [--suggest K [--max-dist D]] [--report] [--stats]\n", prog);
+  fprintf(stderr, "  --compile-dict FILE  read the dictionary from stdin and write its image to FILE\n");
+  fprintf(stderr, "  --dict FILE          check the text on stdin against the image in FILE\n");
+  fprintf(stderr, "  --bloom FPR          reject unknown words with a Bloom filter of false-positive rate FPR first;\n");
+  fprintf(stderr, "                       with --compile-dict the filter is stored in the image and --dict uses it\n");
+  fprintf(stderr, "  --suggest K          print up to K (at most %d) corrections after every unknown word\n", MAX_SUGGEST);
+  fprintf(stderr, "  --max-dist D         only suggest words within edit distance D (default 2)\n");
+  fprintf(stderr, "  --report             print each distinct unknown word once, with its count and first position\n");
+  fprintf(stderr, "  --stats              print timing and lookup statistics to stderr\n");
+}
+
+/*
+ * @brief Prints dictionary, timing, memory and lookup statistics to stderr.
+ *
+ * @param d		Pointer to dictionary.
+ * @param loadTime	Seconds spent building or mapping the dictionary.
+ * @param textTime	Seconds spent reading, checking and reporting the text,
+ * 			suggestions included.
+ */
+void printStats(dict* d, double loadTime, double textTime) {
+  CheckStats* st = &d->stats;
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+
+  fprintf(stderr, "dictionary: %" PRIu32 " words, %" PRIu32 " nodes, loaded in %.3f ms\n",
+          d->wordCount, d->nodeCount, loadTime * 1e3);
+  fprintf(stderr, "checked:    %" PRIu64 " words in %.3f ms of lookups (%.2f Mwords/s)\n",
+          st->checked, st->seconds * 1e3, st->seconds > 0 ? st->checked / st->seconds * 1e-6 : 0.0);
+  fprintf(stderr, "text:       read, checked and reported in %.3f ms\n", textTime * 1e3);
+  fprintf(stderr, "memory:     peak RSS %ld KiB\n", ru.ru_maxrss);
+
+  if (d->bloom != NULL) {
+    uint64_t passed = st->checked - st->bloomRejected;
+    fprintf(stderr, "bloom:      %.1f KiB, k = %d, sized for a false-positive rate of %g\n",
+            d->bloom->nBlocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t) / 1024.0, d->bloom->k, d->bloom->fpr);
+    fprintf(stderr, "bloom:      %" PRIu64 " rejected, %" PRIu64 " passed, %" PRIu64 " false positives (%.4f of unknown)\n",
+            st->bloomRejected, passed, st->falsePositives,
+            st->bloomRejected + st->falsePositives > 0 ? (double)st->falsePositives / (st->bloomRejected + st->falsePositives) : 0.0);
+  }
+}
+
+/*
+ * @brief Main program: builds dictionary, processes text, outputs unknown words.
+ *
+ * @pre   Input must follow format:
+ * 		<dictionary words separated by non-alphabetic characters>
+ * 		%
+ * 		<text>
+ * 	  With --dict only the <text> part is read, with --compile-dict only
+ * 	  the dictionary part.
+ * @post  Unknown words are printed and then their count.
+ *
+ * @return exit (0) on success, 1 on bad arguments or unusable files.
+ */
+int main(int argc, char* argv[]) {
+  const char* compilePath = NULL;  // --compile-dict: write the image here and stop.
+  const char* dictPath = NULL;     // --dict: use this image instead of reading a dictionary.
+  double bloomFpr = 0;             // --bloom: false-positive rate, 0 means no Bloom filter.
+  int suggestCount = 0;            // --suggest: number of corrections per unknown word.
+  int maxDist = 2;                 // --max-dist: largest edit distance of a correction.
+  bool aggregate = false;          // --report: print distinct unknown words with counts.
+  bool stats = false;              // --stats: print statistics to stderr.
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--compile-dict") == 0 && i + 1 < argc) {
+      compilePath = argv[++i];
+    } else if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) {
+      dictPath = argv[++i];
+    } else if (strcmp(argv[i], "--bloom") == 0 && i + 1 < argc) {
+      bloomFpr = strtod(argv[++i], NULL);
+      if (!(bloomFpr > 0 && bloomFpr < 1)) {
+        usage(argv[0]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--suggest") == 0 && i + 1 < argc) {
+      long value = strtol(argv[++i], NULL, 10);
+      if (value < 1 || value > MAX_SUGGEST) {
+        usage(argv[0]);
+        return 1;
+      }
+      suggestCount = (int)value;
+    } else if (strcmp(argv[i], "--max-dist") == 0 && i + 1 < argc) {
+      maxDist = atoi(argv[++i]);
+      if (maxDist < 0) {
+        usage(argv[0]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--report") == 0) {
+      aggregate = true;
+    } else if (strcmp(argv[i], "--stats") == 0) {
+      stats = true;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (compilePath != NULL && dictPath != NULL) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // building a filter from a mapped image would walk all of it on every
+  // start; the filter of an image is chosen when it is compiled
+  if (dictPath != NULL && bloomFpr > 0) {
+    fprintf(stderr, "%s: --bloom goes with --compile-dict; --dict uses the filter stored in the image\n", argv[0]);
+    return 1;
+  }
+
+  // Step 1: read in the dictionary
+  double start = now();
+  dict* dictionary;  // Trie or mapped image storing all valid dictionary words.
+
+  if (dictPath != NULL) {
+    dictionary = mapDict(dictPath);
+    if (dictionary == NULL) {
+      fprintf(stderr, "%s: cannot load dictionary image '%s'\n", argv[0], dictPath);
+      return 1;
+    }
+  } else {
+    dictionary = newEmptyDict();
+    readDictionary(dictionary);
+    if (bloomFpr > 0) {
+      enableBloom(dictionary, bloomFpr);
+    }
+  }
+
+  if (compilePath != NULL) {
+    bool ok = compileDict(dictionary, compilePath);
+    if (!ok) {
+      fprintf(stderr, "%s: cannot write dictionary image '%s'\n", argv[0], compilePath);
+    }
+    freeDict(dictionary);
+    return ok ? 0 : 1;
+  }
+
+  double loadTime = now() - start;
+  dictionary->stats.timed = stats;
+
+  // Step 2: read in text
+  start = now();
+  Report* report = newReport(aggregate, enableColor, dictionary, suggestCount, maxDist);  // Unknown word output.
+
+  char word[LENGTH + 1];  // Currently accumulated word taken from the input text.
+  int index = 0;          // Number of letters in word.
+  uint64_t position = 0;  // Number of words read from the text so far.
   int c;                  // Current character read from input.
 
   if (enableColor) {
@@ -355,23 +1803,7 @@ int main(void) {
       // End of word
       if (index > 0) {
         word[index] = '\0';
-
-        bool known = check(word, dictionary);  // True if the word exists in the dictionary.
-
-        // BONUS: inline full-text colored output
-        if (enableColor) {
-          if (known) {
-            printf("%s", word);
-          } else {
-            printf("\033[31m%s\033[0m", word);
-          }
-        }
-
-        // Store unknown words
-        if (!known) {
-          addUnknown(unknown, word);
-        }
-
+        processWord(word, dictionary, report, ++position);
         index = 0;  // Reset buffer for next word.
       }
 
@@ -385,31 +1817,22 @@ int main(void) {
   // File ended but last word was not flushed if no punctuation in the end (index greater than 0).
   if (index > 0) {
     word[index] = '\0';
-    bool known = check(word, dictionary);  // True if last word exists in dictionary
-
-    // Print whole text with unknown words in red (only if enableColor is set to true)
-    if (enableColor) {
-      if (known) {
-        printf("%s", word);
-      } else {
-        printf("\033[31m%s\033[0m", word);
-      }
-    }
-
-    if (!known) {
-      addUnknown(unknown, word);
-    }
+    processWord(word, dictionary, report, ++position);
   }
 
-  // Step 3: print number of unknown words
-  for (int i = 0; i < unknown->size; i++) {
-    printf("%s\n", unknown->words[i]);
-  }
+  // Step 3: print the held back unknown words and their number
+  finishReport(report);
+  double textTime = now() - start;
 
-  printf("%d\n", unknown->size);  // Print number of unknown words
+  if (stats) {
+    printStats(dictionary, loadTime, textTime);
+    if (report->cache != NULL) {
+      printSuggestStats(report->cache);
+    }
+  }
 
-  freeUnknownList(unknown);  // Free unknown word list
-  freeDict(dictionary);      // Free Trie dictionary.
+  freeReport(report);    // Free unknown word report
+  freeDict(dictionary);  // Free Trie dictionary.
 
   return 0;
 }
@@ -2,7 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "libs/LibTree.h"
+#include "LibTree.h"
 
 // Write a function that converts a tree from array to pointer representation.
 // The tree contains only positive integers, empty places in the array are marked with -1.
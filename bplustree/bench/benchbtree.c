@@ -0,0 +1,252 @@
+/**
+ * @file  benchbtree.c
+ * @brief Random lookups per second and memory per key of a BTree against
+ * a Tree holding the same keys, 10^8 by default. The keys are the even
+ * numbers below 2 * KEYS and the lookups are random numbers in the same
+ * range, so about half of them miss. The Tree is built perfectly balanced
+ * with newTree, the best shape addInSearchTree could give it. Then the
+ * BTree is scanned through its leaves with rangeBTree, and a fresh BTree
+ * takes LOOKUPS random inserts and removals.
+ *
+ * "verify" checks random adds, removals, searches and ranges against a
+ * bitmap, and bulk loading with repeated keys.
+ *
+ * usage: benchbtree verify | benchbtree [KEYS [LOOKUPS]]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LibBTree.h"
+#include "LibTree.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+/*
+ * @brief Resident memory of the process now, from /proc/self/statm
+ */
+long rssBytes(void) {
+  long pages = 0;
+  FILE* f = fopen("/proc/self/statm", "r");
+  if (f != NULL) {
+    fscanf(f, "%*s %ld", &pages);
+    fclose(f);
+  }
+  return pages * sysconf(_SC_PAGESIZE);
+}
+
+/*
+ * @brief Compares the whole tree, through rangeBTree, with the bitmap
+ */
+int sameContents(BTree b, const char* present, int range, int* scratch) {
+  long found = rangeBTree(b, INT_MIN, INT_MAX, scratch, range + 1);
+  long j = 0;
+  for (int n = 0; n < range; n++) {
+    if (present[n] && (j >= found || scratch[j++] != n)) {
+      return 0;
+    }
+  }
+  return j == found && found == sizeBTree(b);
+}
+
+int verify(void) {
+  enum { RANGE = 400000, STEPS = 4000000 };
+  char* present = calloc(RANGE, 1);
+  int* scratch = malloc((RANGE + 1) * sizeof(int));
+  uint64_t x = 88172645463325252u;
+  BTree b = newBTree();
+  int maxHeight = 1;
+  for (int step = 0; step < STEPS; step++) {
+    int n = (int)(xorshift(&x) % RANGE);
+    // add more often in the first half, remove more often in the second
+    if (xorshift(&x) % STEPS < (uint64_t)(STEPS - step)) {
+      if (addInBTree(b, n) != !present[n]) {
+        printf("addInBTree(%d) wrong at step %d\n", n, step);
+        return 1;
+      }
+      present[n] = 1;
+    } else {
+      if (removeFromBTree(b, n) != present[n]) {
+        printf("removeFromBTree(%d) wrong at step %d\n", n, step);
+        return 1;
+      }
+      present[n] = 0;
+    }
+    int m = (int)(xorshift(&x) % RANGE);
+    if (searchBTree(b, m) != present[m]) {
+      printf("searchBTree(%d) wrong at step %d\n", m, step);
+      return 1;
+    }
+    int low = (int)(xorshift(&x) % RANGE);
+    int high = low + (int)(xorshift(&x) % 300);
+    long inRange = 0;
+    for (int k = low; k <= high && k < RANGE; k++) {
+      inRange += present[k];
+    }
+    if (rangeBTree(b, low, high, NULL, LONG_MAX) != inRange) {
+      printf("rangeBTree(%d, %d) wrong at step %d\n", low, high, step);
+      return 1;
+    }
+    if (step % 100000 == 0 && !sameContents(b, present, RANGE, scratch)) {
+      printf("contents wrong at step %d\n", step);
+      return 1;
+    }
+    maxHeight = heightBTree(b) > maxHeight ? heightBTree(b) : maxHeight;
+  }
+  if (!sameContents(b, present, RANGE, scratch)) {
+    printf("contents wrong at the end\n");
+    return 1;
+  }
+  freeBTree(b);
+
+  // bulk load every third number, each twice, then remove all in random order
+  long n = 0;
+  for (int k = 0; k < RANGE; k += 3) {
+    scratch[n++] = k;
+    scratch[n++] = k;
+  }
+  b = bulkLoadBTree(scratch, n);
+  memset(present, 0, RANGE);
+  for (int k = 0; k < RANGE; k += 3) {
+    present[k] = 1;
+  }
+  if (sizeBTree(b) != n / 2 || !sameContents(b, present, RANGE, scratch)) {
+    printf("bulkLoadBTree wrong\n");
+    return 1;
+  }
+  for (int k = 0; k < RANGE; k++) {
+    int r = (int)(xorshift(&x) % RANGE);
+    if (removeFromBTree(b, r) != present[r]) {
+      printf("bulk loaded tree wrong removing %d\n", r);
+      return 1;
+    }
+    present[r] = 0;
+    if (addInBTree(b, k) != !present[k]) {
+      printf("bulk loaded tree wrong adding %d\n", k);
+      return 1;
+    }
+    present[k] = 1;
+  }
+  for (int k = 0; k < RANGE; k++) {
+    if (removeFromBTree(b, k) != present[k]) {
+      printf("bulk loaded tree wrong emptying it at %d\n", k);
+      return 1;
+    }
+  }
+  if (sizeBTree(b) != 0 || heightBTree(b) != 1 || searchBTree(b, 0)) {
+    printf("emptied tree wrong\n");
+    return 1;
+  }
+  freeBTree(b);
+  free(present);
+  free(scratch);
+  printf("BTree matches the reference (height up to %d)\n", maxHeight);
+  return 0;
+}
+
+Tree buildTree(const int* keys, long low, long high) {
+  if (low >= high) {
+    return emptyTree();
+  }
+  long mid = low + (high - low) / 2;
+  return newTree(keys[mid], buildTree(keys, low, mid), buildTree(keys, mid + 1, high));
+}
+
+long sumTree(Tree t) {
+  return t == NULL ? 0 : sumTree(t->leftChild) + t->item + sumTree(t->rightChild);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  long n = argc > 1 ? atol(argv[1]) : 100000000;
+  long lookups = argc > 2 ? atol(argv[2]) : 10000000;
+  int* keys = malloc(n * sizeof(int));
+  int* probes = malloc(lookups * sizeof(int));
+  uint64_t x = 88172645463325252u;
+  for (long i = 0; i < n; i++) {
+    keys[i] = (int)(2 * i);
+  }
+  for (long i = 0; i < lookups; i++) {
+    probes[i] = (int)(xorshift(&x) % (uint64_t)(2 * n));
+  }
+  printf("%ld keys, %ld random lookups\n", n, lookups);
+
+  long rss = rssBytes();
+  double t = now();
+  BTree b = bulkLoadBTree(keys, n);
+  double build = now() - t;
+  double bytes = (double)(rssBytes() - rss) / n;
+  t = now();
+  long found = 0;
+  for (long i = 0; i < lookups; i++) {
+    found += searchBTree(b, probes[i]);
+  }
+  double search = now() - t;
+  printf("%-28s build %6.2f s  %6.2f M lookups/s  %6.2f bytes/key (%.2f counted)  height %d  (found %ld)\n",
+         "BTree, bulk loaded", build, lookups / search * 1e-6, bytes, (double)bytesBTree(b) / n, heightBTree(b), found);
+
+  rss = rssBytes();
+  t = now();
+  Tree tree = buildTree(keys, 0, n);
+  build = now() - t;
+  bytes = (double)(rssBytes() - rss) / n;
+  t = now();
+  found = 0;
+  for (long i = 0; i < lookups; i++) {
+    found += searchNode(tree, probes[i]) != NULL;
+  }
+  search = now() - t;
+  printf("%-28s build %6.2f s  %6.2f M lookups/s  %6.2f bytes/key                  height %d  (found %ld)\n",
+         "Tree, balanced", build, lookups / search * 1e-6, bytes, heightTree(tree), found);
+
+  // in-order scans: the linked leaves against a recursive walk
+  t = now();
+  long scanned = rangeBTree(b, INT_MIN, INT_MAX, NULL, LONG_MAX);
+  double scan = now() - t;
+  t = now();
+  long sum = sumTree(tree);
+  printf("in-order scan: BTree leaves %.1f M keys/s, Tree walk %.1f M keys/s  (%ld keys, sum %ld)\n", scanned / scan * 1e-6,
+         n / (now() - t) * 1e-6, scanned, sum);
+  freeTree(tree);
+  freeBTree(b);
+  free(keys);
+
+  // one by one into an empty tree
+  b = newBTree();
+  t = now();
+  for (long i = 0; i < lookups; i++) {
+    addInBTree(b, probes[i]);
+  }
+  double add = now() - t;
+  long size = sizeBTree(b);
+  double bytesPerKey = (double)bytesBTree(b) / size;
+  t = now();
+  for (long i = 0; i < lookups; i++) {
+    removeFromBTree(b, probes[i]);
+  }
+  printf("BTree, random keys one by one: add %.2f M/s (%.2f bytes/key), remove %.2f M/s  (%ld keys, %ld left)\n",
+         lookups / add * 1e-6, bytesPerKey, lookups / (now() - t) * 1e-6, size, sizeBTree(b));
+  freeBTree(b);
+  free(probes);
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibBTree.h"
+
+// Keep a set of numbers under a sequence of commands:
+//   + n     add n
+//   - n     remove n, if it is there
+//   ? n     tell whether n is there
+//   r a b   print the numbers from a to b
+// and print the numbers in order at the end. The B+-tree answers each
+// command in a few cache misses per level, and its leaves are linked,
+// so the numbers of a range are read one leaf after another.
+
+int main(void) {
+  int count = 0;
+  printf("How many commands?\n");
+  scanf("%d", &count);
+  BTree b = newBTree();
+  printf("Please enter the commands, one per line:\n");
+  for (int i = 0; i < count; i++) {
+    char command;
+    int n;
+    if (scanf(" %c %d", &command, &n) != 2) {
+      break;
+    }
+    if (command == '+') {
+      addInBTree(b, n);
+    } else if (command == '-') {
+      if (!removeFromBTree(b, n)) {
+        printf("%d was not there\n", n);
+      }
+    } else if (command == '?') {
+      printf("%d is %s\n", n, searchBTree(b, n) ? "there" : "not there");
+    } else if (command == 'r') {
+      int high;
+      if (scanf("%d", &high) != 1) {
+        break;
+      }
+      long found = rangeBTree(b, n, high, NULL, sizeBTree(b));
+      int* range = malloc((found + 1) * sizeof(int));
+      rangeBTree(b, n, high, range, found);
+      printf("From %d to %d:", n, high);
+      for (long j = 0; j < found; j++) {
+        printf(" %d", range[j]);
+      }
+      printf("\n");
+      free(range);
+    }
+  }
+  printf("The %ld numbers in order:\n", sizeBTree(b));
+  inOrderBTree(b);
+  freeBTree(b);
+  exit(0);
+}
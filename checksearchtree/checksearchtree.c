@@ -2,7 +2,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
-#include "libs/LibTree.h"
+#include "LibTree.h"
 
 // Write a function to check if a given tree is a search tree.
 
@@ -0,0 +1,187 @@
+/**
+ * @file  benchdeque.c
+ * @brief Per-operation latency and peak memory of the segmented LibDeque
+ * against a doubling ring buffer (DEFINE_QUEUE from ../queue).
+ *
+ * usage: benchdeque verify
+ *        benchdeque deque|array [ITEMS]   (default 100000000)
+ *
+ * Each variant should run in its own process: peak RSS is per process.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "LibDeque.h"
+#include "LibQueueTemplate.h"
+
+DEFINE_QUEUE(Ring, int)
+
+/* latency histogram: 1 ns buckets up to 64 us, everything slower in the last one */
+#define BUCKETS 65536
+
+typedef struct Latency {
+  uint64_t counts[BUCKETS];
+  uint64_t total;
+  uint64_t worst;
+} Latency;
+
+uint64_t nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+void record(Latency* lat, uint64_t ns) {
+  lat->counts[ns < BUCKETS ? ns : BUCKETS - 1]++;
+  lat->total += ns;
+  if (ns > lat->worst) {
+    lat->worst = ns;
+  }
+}
+
+uint64_t percentile(Latency* lat, long ops, double p) {
+  uint64_t want = (uint64_t)(ops * p), seen = 0;
+  for (int i = 0; i < BUCKETS; i++) {
+    seen += lat->counts[i];
+    if (seen > want) {
+      return i;
+    }
+  }
+  return BUCKETS - 1;
+}
+
+void report(const char* name, Latency* lat, long ops) {
+  printf("%-22s %6.1f ns/op  p50 %4lu ns  p99.9 %5lu ns  worst %9.1f us\n", name, (double)lat->total / ops,
+         (unsigned long)percentile(lat, ops, 0.5), (unsigned long)percentile(lat, ops, 0.999), lat->worst * 1e-3);
+}
+
+long peakRssKb(void) {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_maxrss;
+}
+
+/* random mix of all eight operations, checked against a plain array */
+int verify(void) {
+  long cap = 1 << 22, lo = cap / 2, hi = cap / 2;
+  int* ref = malloc(cap * sizeof(int));
+  Deque d = newDeque();
+  uint64_t x = 88172645463325252u;
+  for (long i = 0; i < 20000000; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    /* drift between growing and shrinking phases so blocks and the map are recycled */
+    int growing = (i >> 18) & 1;
+    int op = x % 8;
+    int item = (int)(x >> 32);
+    if (op < 2 + growing * 2 && lo > 0 && hi < cap) {
+      if (op & 1) {
+        pushFront(item, d);
+        ref[--lo] = item;
+      } else {
+        pushBack(item, d);
+        ref[hi++] = item;
+      }
+    } else if (lo < hi) {
+      int got, want;
+      switch (op % 4) {
+        case 0:
+          got = popFront(d), want = ref[lo++];
+          break;
+        case 1:
+          got = popBack(d), want = ref[--hi];
+          break;
+        case 2:
+          got = peekFront(d), want = ref[lo];
+          break;
+        default:
+          got = peekBack(d), want = ref[hi - 1];
+      }
+      if (got != want) {
+        printf("verify: step %ld, op %d: got %d, want %d\n", i, op, got, want);
+        return 1;
+      }
+    }
+    if (lengthDeque(d) != hi - lo || isEmptyDeque(d) != (lo == hi)) {
+      printf("verify: step %ld: length %d, want %ld\n", i, lengthDeque(d), hi - lo);
+      return 1;
+    }
+    if (lo == hi) {
+      lo = hi = cap / 2;
+    }
+  }
+  freeDeque(d);
+  free(ref);
+  printf("verify: ok\n");
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s verify | deque ITEMS | array ITEMS\n", argv[0]);
+    return 2;
+  }
+  if (strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  long items = argc > 2 ? atol(argv[2]) : 100000000;
+  int useDeque = strcmp(argv[1], "deque") == 0;
+  Latency* push = calloc(1, sizeof(Latency));
+  Latency* pop = calloc(1, sizeof(Latency));
+  long checksum = 0;
+
+  /* FIFO that grows: two pushes per pop, so the ring is wrapped when it doubles */
+  if (useDeque) {
+    Deque d = newDeque();
+    for (long i = 0; i < items; i++) {
+      uint64_t t = nowNs();
+      pushBack((int)i, d);
+      record(push, nowNs() - t);
+      if (i % 2 == 1) {
+        t = nowNs();
+        checksum += popFront(d);
+        record(pop, nowNs() - t);
+      }
+    }
+    while (!isEmptyDeque(d)) {
+      uint64_t t = nowNs();
+      checksum += popFront(d);
+      record(pop, nowNs() - t);
+    }
+    freeDeque(d);
+  } else {
+    Ring* q = newRing(8);
+    for (long i = 0; i < items; i++) {
+      uint64_t t = nowNs();
+      enqueueRing((int)i, q);
+      record(push, nowNs() - t);
+      if (i % 2 == 1) {
+        t = nowNs();
+        checksum += dequeueRing(q);
+        record(pop, nowNs() - t);
+      }
+    }
+    while (!isEmptyRing(q)) {
+      uint64_t t = nowNs();
+      checksum += dequeueRing(q);
+      record(pop, nowNs() - t);
+    }
+    freeRing(q);
+  }
+
+  printf("%s, %ld items (checksum %ld), timer overhead included\n", useDeque ? "segmented deque" : "doubling ring", items, checksum);
+  report("  push back", push, items);
+  report("  pop front", pop, items);
+  printf("  peak RSS %ld MiB (at most %ld MiB of items live)\n", peakRssKb() / 1024, (items / 2) * (long)sizeof(int) >> 20);
+  free(push);
+  free(pop);
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDeque.h"
+
+// Sliding window maximum: for every window of k consecutive numbers,
+// print the largest one. The deque holds positions of the numbers in the
+// current window whose values are decreasing from front to back, so the
+// front is always the position of the maximum. Every position is pushed
+// and popped at most once, which makes the whole computation O(n).
+
+void windowMaxima(int arr[], int n, int k) {
+  Deque d = newDeque();
+  for (int i = 0; i < n; i++) {
+    // drop the position that just left the window
+    if (!isEmptyDeque(d) && peekFront(d) <= i - k) {
+      popFront(d);
+    }
+    // smaller values before i can never be a maximum again
+    while (!isEmptyDeque(d) && arr[peekBack(d)] <= arr[i]) {
+      popBack(d);
+    }
+    pushBack(i, d);
+    if (i >= k - 1) {
+      printf("%d\n", arr[peekFront(d)]);
+    }
+  }
+  freeDeque(d);
+}
+
+int main(void) {
+  int count = 0;
+  int k = 0;
+  printf("How many numbers?\n");
+  scanf("%d", &count);
+  printf("What is the window size?\n");
+  scanf("%d", &k);
+  int* arr = malloc(count * sizeof(int));
+  printf("Please enter the numbers, one per line:\n");
+  for (int i = 0; i < count; i++) {
+    scanf("%d", &arr[i]);
+  }
+  printf("The maxima of all windows of size %d are:\n", k);
+  windowMaxima(arr, count, k);
+  free(arr);
+  exit(0);
+}
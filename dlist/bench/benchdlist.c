@@ -0,0 +1,207 @@
+/**
+ * @file  benchdlist.c
+ * @brief Mixed inserts and removals by value on a DList against a plain
+ * List, where removeItem and a removeLastOccurrence like the one in
+ * removelast.c walk the list.
+ *
+ * The list starts with ITEMS random values from a range of ITEMS / 4,
+ * then OPS operations follow: half add a value at the front, a quarter
+ * remove its first occurrence and a quarter its last occurrence.
+ * "verify" runs the same kind of operations on a DList and an array.
+ *
+ * usage: benchdlist verify | benchdlist list|dlist [OPS [ITEMS]]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LibDList.h"
+#include "LibList.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+// as removelast.c, without the exercise's firstItem calls
+int removeLastOccurrence(List* lp, int n) {
+  List prev = NULL;
+  List prevLast = NULL;
+  List lastMatch = NULL;
+  for (List current = *lp; current != NULL; prev = current, current = current->next) {
+    if (current->item == n) {
+      prevLast = prev;
+      lastMatch = current;
+    }
+  }
+  if (lastMatch == NULL) {
+    return 0;
+  }
+  if (prevLast == NULL) {
+    *lp = removeFirstNode(*lp);
+  } else {
+    prevLast->next = removeFirstNode(prevLast->next);
+  }
+  return 1;
+}
+
+void fail(const char* what, long step) {
+  fprintf(stderr, "mismatch in %s at step %ld\n", what, step);
+  exit(1);
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  int capacity = 10000;
+  int* model = malloc(capacity * sizeof(int));
+  int n = 0;
+  DList d = newDList();
+  for (long step = 0; step < 300000; step++) {
+    int r = (int)(xorshift(&x) % 6);
+    int value = (int)(xorshift(&x) % 300);
+    int first = 0;
+    while (first < n && model[first] != value) {
+      first++;
+    }
+    int last = n - 1;
+    while (last >= 0 && model[last] != value) {
+      last--;
+    }
+    if ((r == 0 || r == 1) && n < capacity) {
+      memmove(model + 1, model, n * sizeof(int));
+      model[0] = value;
+      n++;
+      pushFrontDList(value, d);
+    } else if (r == 2 && n < capacity) {
+      model[n++] = value;
+      pushBackDList(value, d);
+    } else if (r == 3) {
+      if (removeFirstDList(value, d) != (first < n)) {
+        fail("removeFirstDList", step);
+      }
+      if (first < n) {
+        memmove(model + first, model + first + 1, (n - first - 1) * sizeof(int));
+        n--;
+      }
+    } else if (r == 4) {
+      if (removeLastDList(value, d) != (last >= 0)) {
+        fail("removeLastDList", step);
+      }
+      if (last >= 0) {
+        memmove(model + last, model + last + 1, (n - last - 1) * sizeof(int));
+        n--;
+      }
+    } else if (n > 0) {
+      if (xorshift(&x) % 2 == 0) {
+        if (popFrontDList(d) != model[0]) {
+          fail("popFrontDList", step);
+        }
+        memmove(model, model + 1, (n - 1) * sizeof(int));
+      } else if (popBackDList(d) != model[n - 1]) {
+        fail("popBackDList", step);
+      }
+      n--;
+    }
+    if (lengthDList(d) != n || isInDList(value, d) != (countInDList(value, d) > 0)) {
+      fail("length", step);
+    }
+    if (step % 1000 == 0) {
+      int i = 0;
+      for (DNode* p = firstDList(d); p != NULL; p = p->next, i++) {
+        if (i >= n || p->item != model[i] || (p->next != NULL && p->next->prev != p)) {
+          fail("iteration", step);
+        }
+      }
+      int c = 0;
+      for (i = 0; i < n; i++) {
+        c += model[i] == value;
+      }
+      if (countInDList(value, d) != c) {
+        fail("countInDList", step);
+      }
+    }
+  }
+  freeDList(d);
+  free(model);
+  printf("DList matches the array model\n");
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  if (argc < 2 || (strcmp(argv[1], "list") != 0 && strcmp(argv[1], "dlist") != 0)) {
+    fprintf(stderr, "usage: %s verify | %s list|dlist [OPS [ITEMS]]\n", argv[0], argv[0]);
+    return 1;
+  }
+  int useDList = strcmp(argv[1], "dlist") == 0;
+  long ops = argc > 2 ? atol(argv[2]) : 1000000;
+  int items = argc > 3 ? atoi(argv[3]) : 10000;
+  int range = items / 4 > 0 ? items / 4 : 1;
+  uint64_t x = 88172645463325252u;
+  List li = newEmptyList();
+  DList d = newDList();
+  for (int i = 0; i < items; i++) {
+    int value = (int)(xorshift(&x) % range);
+    if (useDList) {
+      pushFrontDList(value, d);
+    } else {
+      li = addItem(value, li);
+    }
+  }
+  double t = now();
+  for (long i = 0; i < ops; i++) {
+    uint64_t r = xorshift(&x);
+    int value = (int)((r >> 8) % range);
+    if (r % 4 < 2) {
+      if (useDList) {
+        pushFrontDList(value, d);
+      } else {
+        li = addItem(value, li);
+      }
+    } else if (r % 4 == 2) {
+      if (useDList) {
+        removeFirstDList(value, d);
+      } else {
+        li = removeItem(li, value);
+      }
+    } else {
+      if (useDList) {
+        removeLastDList(value, d);
+      } else {
+        removeLastOccurrence(&li, value);
+      }
+    }
+  }
+  t = now() - t;
+  long length = 0;
+  long checksum = 0;
+  if (useDList) {
+    for (DNode* p = firstDList(d); p != NULL; p = p->next, length++) {
+      checksum = checksum * 31 + p->item;
+    }
+  } else {
+    for (List p = li; p != NULL; p = p->next, length++) {
+      checksum = checksum * 31 + p->item;
+    }
+  }
+  printf("%-5s %8d items at the start %8.1f ns/op %8.3f Mops/s   (length %ld, checksum %ld)\n", argv[1], items,
+         t * 1e9 / ops, ops / t * 1e-6, length, checksum);
+  freeList(li);
+  freeDList(d);
+  return 0;
+}
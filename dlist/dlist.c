@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDList.h"
+
+// Read a list of numbers, then commands that remove numbers from it:
+//   f n   remove the first occurrence of n
+//   l n   remove the last occurrence of n
+//   ? n   tell how often n occurs
+// and print the list after every removal. The DList finds the first and
+// last occurrence of a number through its index, without walking the
+// list.
+
+int main(void) {
+  int count = 0;
+  printf("How many numbers?\n");
+  scanf("%d", &count);
+  DList d = newDList();
+  printf("Please enter %d numbers, one per line:\n", count);
+  for (int i = 0; i < count; i++) {
+    int next;
+    scanf("%d", &next);
+    pushBackDList(next, d);
+  }
+  printf("How many commands?\n");
+  scanf("%d", &count);
+  for (int i = 0; i < count; i++) {
+    char command;
+    int n;
+    if (scanf(" %c %d", &command, &n) != 2) {
+      break;
+    }
+    if (command == '?') {
+      printf("%d occurs %d times\n", n, countInDList(n, d));
+      continue;
+    }
+    int removed = command == 'f' ? removeFirstDList(n, d) : removeLastDList(n, d);
+    if (!removed) {
+      printf("%d does not occur\n", n);
+      continue;
+    }
+    printf("After removing the %s %d: ", command == 'f' ? "first" : "last", n);
+    printDList(d);
+    printf("\n");
+  }
+  freeDList(d);
+  exit(0);
+}
@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "libs/LibQueue.h"
+#include "LibQueue.h"
 
 int main(void) {
   // Write a program to manage the waiting room of a doctor using a queue.
@@ -3,7 +3,7 @@
 #include <stdlib.h>
 
 // For graphs without weights we can reuse the list library.
-#include "libs/LibList.h"
+#include "LibList.h"
 
 // Note: this is *not* the same as the typedef in the slides.
 typedef struct ListGraph {
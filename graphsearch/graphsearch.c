@@ -3,8 +3,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "libs/LibList.h"
-#include "libs/LibQueue.h"
+#include "LibList.h"
+#include "LibQueue.h"
 
 // The goal in this exercise is to implement four different search alogrithms:
 //
@@ -128,6 +128,7 @@ void lDFS_helper(ListGraph lg, int v, List* visited, List* newEdges, List* oldEd
 }
 
 void lDFS(ListGraph lg, int v) {
+  ListPool* previous = useListPool(newListPool());
   List visited = newEmptyList();
   List* newEdges = malloc(lg.N * sizeof(List));
   for (int x = 0; x < lg.N; x++) {
@@ -138,17 +139,15 @@ void lDFS(ListGraph lg, int v) {
     oldEdges[x] = newEmptyList();
   }
   lDFS_helper(lg, v, &visited, newEdges, oldEdges);
-  for (int x = 0; x < lg.N; x++) {
-    freeList(newEdges[x]);
-    freeList(oldEdges[x]);
-  }
+  // the lists of newEdges, oldEdges and visited all go at once
+  freeListPool(useListPool(previous));
   free(newEdges);
   free(oldEdges);
-  freeList(visited);
 }
 
 // (d) BFS for the adjacency list representation
 void lBFS(ListGraph lg, int v) {
+  ListPool* previous = useListPool(newListPool());
   List visited = newEmptyList();
   List* newEdges = malloc(lg.N * sizeof(List));
   for (int x = 0; x < lg.N; x++) {
@@ -187,13 +186,10 @@ void lBFS(ListGraph lg, int v) {
 
   freeQueue(q);
 
-  for (int x = 0; x < lg.N; x++) {
-    freeList(newEdges[x]);
-    freeList(oldEdges[x]);
-  }
+  // the lists of newEdges, oldEdges and visited all go at once
+  freeListPool(useListPool(previous));
   free(newEdges);
   free(oldEdges);
-  freeList(visited);
 }
 
 // do not modify this function
@@ -0,0 +1,496 @@
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "LibBTree.h"
+
+#define NODE_BYTES 512
+#define LEAF_KEYS 120
+#define INNER_KEYS 40
+#define LEAF_MIN (LEAF_KEYS / 2)
+#define INNER_MIN (INNER_KEYS / 2)
+// inner levels on a path; with at least 21 children each, 32 levels are more than any tree needs
+#define MAX_DEPTH 32
+#define CHUNK_SIZE 65536 /* nodes are carved from chunks of this size */
+
+typedef struct BLeaf {
+  int keys[LEAF_KEYS];
+  int count;
+  struct BLeaf* next;
+} BLeaf;
+
+/*
+ * keys[i] separates children[i] and children[i + 1]: the keys under
+ * children[i] are below it, those under children[i + 1] at least it
+ */
+typedef struct BInner {
+  int keys[INNER_KEYS];
+  int count;  // of keys; there are count + 1 children
+  void* children[INNER_KEYS + 1];
+} BInner;
+
+_Static_assert(sizeof(BLeaf) <= NODE_BYTES && sizeof(BInner) <= NODE_BYTES, "B+-tree nodes must fit in NODE_BYTES");
+
+typedef struct BChunk {
+  struct BChunk* next;
+} BChunk;
+
+typedef struct BTreeS {
+  void* root;
+  int height;  // 1 while the root is a leaf
+  long size;
+  BLeaf* first;
+  // the pool: a free list of nodes, and the unused rest of the newest chunk
+  void* freeNodes;
+  BChunk* chunks;
+  long chunkCount;
+  char* fresh;
+  char* freshEnd;
+} BTreeS;
+
+/*
+ * @brief Takes a node from the pool; the chunks are aligned, so every
+ * node starts on its own cache line
+ */
+static void* newNode(BTree b) {
+  void* node = b->freeNodes;
+  if (node != NULL) {
+    b->freeNodes = *(void**)node;
+    return node;
+  }
+  if (b->fresh == b->freshEnd) {
+    // the first node of a chunk links it to the others
+    BChunk* chunk = aligned_alloc(NODE_BYTES, CHUNK_SIZE);
+    assert(chunk != NULL);
+    chunk->next = b->chunks;
+    b->chunks = chunk;
+    b->chunkCount++;
+    b->fresh = (char*)chunk + NODE_BYTES;
+    b->freshEnd = (char*)chunk + CHUNK_SIZE;
+  }
+  node = b->fresh;
+  b->fresh += NODE_BYTES;
+  return node;
+}
+
+static void freeNode(BTree b, void* node) {
+  *(void**)node = b->freeNodes;
+  b->freeNodes = node;
+}
+
+static BLeaf* newLeaf(BTree b) {
+  BLeaf* leaf = newNode(b);
+  leaf->count = 0;
+  leaf->next = NULL;
+  return leaf;
+}
+
+static BInner* newInner(BTree b) {
+  BInner* inner = newNode(b);
+  inner->count = 0;
+  return inner;
+}
+
+BTree newBTree(void) {
+  BTree b = malloc(sizeof(BTreeS));
+  assert(b != NULL);
+  b->height = 1;
+  b->size = 0;
+  b->freeNodes = NULL;
+  b->chunks = NULL;
+  b->chunkCount = 0;
+  b->fresh = b->freshEnd = NULL;
+  b->first = newLeaf(b);
+  b->root = b->first;
+  return b;
+}
+
+long sizeBTree(BTree b) {
+  return b->size;
+}
+
+int heightBTree(BTree b) {
+  return b->height;
+}
+
+size_t bytesBTree(BTree b) {
+  return sizeof(BTreeS) + (size_t)b->chunkCount * CHUNK_SIZE;
+}
+
+/*
+ * @brief Returns how many of the count sorted keys are at most n: the
+ * child to descend into in an inner node
+ */
+static int countAtMost(const int* keys, int count, int n) {
+  int i = 0;
+#if defined(__AVX2__)
+  __m256i key8 = _mm256_set1_epi32(n);
+  for (; i + 8 <= count; i += 8) {
+    __m256i above = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(keys + i)), key8);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(above));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  __m128i key4 = _mm_set1_epi32(n);
+  for (; i + 4 <= count; i += 4) {
+    __m128i above = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(keys + i)), key4);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(above));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+  while (i < count && keys[i] <= n) {
+    i++;
+  }
+  return i;
+}
+
+/*
+ * @brief Returns how many of the count sorted keys are below n: the
+ * position of n in a leaf
+ */
+static int countBelow(const int* keys, int count, int n) {
+  return n == INT_MIN ? 0 : countAtMost(keys, count, n - 1);
+}
+
+/*
+ * @brief Descends to the leaf where n belongs
+ *
+ * @param path If not NULL, gets the inner nodes on the way, root first
+ * @param index Gets the child taken in each of them
+ */
+static BLeaf* findLeaf(BTree b, int n, BInner** path, int* index) {
+  void* node = b->root;
+  for (int level = 0; level < b->height - 1; level++) {
+    BInner* inner = node;
+    int i = countAtMost(inner->keys, inner->count, n);
+    if (path != NULL) {
+      path[level] = inner;
+      index[level] = i;
+    }
+    node = inner->children[i];
+  }
+  return node;
+}
+
+int searchBTree(BTree b, int n) {
+  BLeaf* leaf = findLeaf(b, n, NULL, NULL);
+  int i = countBelow(leaf->keys, leaf->count, n);
+  return i < leaf->count && leaf->keys[i] == n;
+}
+
+/*
+ * @brief Puts key at position i of an inner node with room, and child
+ * right of it
+ */
+static void insertInner(BInner* inner, int i, int key, void* child) {
+  memmove(inner->keys + i + 1, inner->keys + i, (inner->count - i) * sizeof(int));
+  memmove(inner->children + i + 2, inner->children + i + 1, (inner->count - i) * sizeof(void*));
+  inner->keys[i] = key;
+  inner->children[i + 1] = child;
+  inner->count++;
+}
+
+/*
+ * @brief Removes keys[i] and the child right of it from an inner node
+ */
+static void removeFromInner(BInner* inner, int i) {
+  memmove(inner->keys + i, inner->keys + i + 1, (inner->count - i - 1) * sizeof(int));
+  memmove(inner->children + i + 1, inner->children + i + 2, (inner->count - i - 1) * sizeof(void*));
+  inner->count--;
+}
+
+/*
+ * @brief Splits a full leaf while inserting n at position i
+ * @return The new right half, linked in after leaf
+ */
+static BLeaf* splitLeaf(BTree b, BLeaf* leaf, int i, int n) {
+  int all[LEAF_KEYS + 1];
+  memcpy(all, leaf->keys, i * sizeof(int));
+  all[i] = n;
+  memcpy(all + i + 1, leaf->keys + i, (LEAF_KEYS - i) * sizeof(int));
+  BLeaf* right = newLeaf(b);
+  leaf->count = (LEAF_KEYS + 1) / 2;
+  right->count = LEAF_KEYS + 1 - leaf->count;
+  memcpy(leaf->keys, all, leaf->count * sizeof(int));
+  memcpy(right->keys, all + leaf->count, right->count * sizeof(int));
+  right->next = leaf->next;
+  leaf->next = right;
+  return right;
+}
+
+/*
+ * @brief Splits a full inner node while inserting key and child at i
+ *
+ * @param up Gets the key that separates the two halves in the parent
+ * @return The new right half
+ */
+static BInner* splitInner(BTree b, BInner* inner, int i, int key, void* child, int* up) {
+  int keys[INNER_KEYS + 1];
+  void* children[INNER_KEYS + 2];
+  memcpy(keys, inner->keys, i * sizeof(int));
+  keys[i] = key;
+  memcpy(keys + i + 1, inner->keys + i, (INNER_KEYS - i) * sizeof(int));
+  memcpy(children, inner->children, (i + 1) * sizeof(void*));
+  children[i + 1] = child;
+  memcpy(children + i + 2, inner->children + i + 1, (INNER_KEYS - i) * sizeof(void*));
+  BInner* right = newInner(b);
+  inner->count = INNER_KEYS / 2;
+  right->count = INNER_KEYS - inner->count;
+  *up = keys[inner->count];
+  memcpy(inner->keys, keys, inner->count * sizeof(int));
+  memcpy(inner->children, children, (inner->count + 1) * sizeof(void*));
+  memcpy(right->keys, keys + inner->count + 1, right->count * sizeof(int));
+  memcpy(right->children, children + inner->count + 1, (right->count + 1) * sizeof(void*));
+  return right;
+}
+
+int addInBTree(BTree b, int n) {
+  BInner* path[MAX_DEPTH];
+  int index[MAX_DEPTH];
+  BLeaf* leaf = findLeaf(b, n, path, index);
+  int i = countBelow(leaf->keys, leaf->count, n);
+  if (i < leaf->count && leaf->keys[i] == n) {
+    return 0;
+  }
+  b->size++;
+  if (leaf->count < LEAF_KEYS) {
+    memmove(leaf->keys + i + 1, leaf->keys + i, (leaf->count - i) * sizeof(int));
+    leaf->keys[i] = n;
+    leaf->count++;
+    return 1;
+  }
+  // split nodes bottom-up until one has room for the new separator
+  void* child = splitLeaf(b, leaf, i, n);
+  int key = ((BLeaf*)child)->keys[0];
+  for (int level = b->height - 2; level >= 0; level--) {
+    if (path[level]->count < INNER_KEYS) {
+      insertInner(path[level], index[level], key, child);
+      return 1;
+    }
+    child = splitInner(b, path[level], index[level], key, child, &key);
+  }
+  BInner* root = newInner(b);
+  root->count = 1;
+  root->keys[0] = key;
+  root->children[0] = b->root;
+  root->children[1] = child;
+  b->root = root;
+  b->height++;
+  return 1;
+}
+
+/*
+ * @brief Refills the leaf children[c] of parent, which has one key too
+ * few, from a sibling, or merges it with one
+ */
+static void fixLeaf(BTree b, BInner* parent, int c) {
+  BLeaf* leaf = parent->children[c];
+  BLeaf* left = c > 0 ? parent->children[c - 1] : NULL;
+  BLeaf* right = c < parent->count ? parent->children[c + 1] : NULL;
+  if (left != NULL && left->count > LEAF_MIN) {
+    memmove(leaf->keys + 1, leaf->keys, leaf->count * sizeof(int));
+    leaf->keys[0] = left->keys[--left->count];
+    leaf->count++;
+    parent->keys[c - 1] = leaf->keys[0];
+  } else if (right != NULL && right->count > LEAF_MIN) {
+    leaf->keys[leaf->count++] = right->keys[0];
+    memmove(right->keys, right->keys + 1, --right->count * sizeof(int));
+    parent->keys[c] = right->keys[0];
+  } else {
+    // merge the right one of the two leaves into the left one
+    if (left != NULL) {
+      right = leaf;
+      leaf = left;
+      c--;
+    }
+    memcpy(leaf->keys + leaf->count, right->keys, right->count * sizeof(int));
+    leaf->count += right->count;
+    leaf->next = right->next;
+    freeNode(b, right);
+    removeFromInner(parent, c);
+  }
+}
+
+/*
+ * @brief Refills the inner node children[c] of parent, which has one key
+ * too few, through parent from a sibling, or merges it with one
+ */
+static void fixInner(BTree b, BInner* parent, int c) {
+  BInner* inner = parent->children[c];
+  BInner* left = c > 0 ? parent->children[c - 1] : NULL;
+  BInner* right = c < parent->count ? parent->children[c + 1] : NULL;
+  if (left != NULL && left->count > INNER_MIN) {
+    memmove(inner->keys + 1, inner->keys, inner->count * sizeof(int));
+    memmove(inner->children + 1, inner->children, (inner->count + 1) * sizeof(void*));
+    inner->keys[0] = parent->keys[c - 1];
+    inner->children[0] = left->children[left->count];
+    inner->count++;
+    parent->keys[c - 1] = left->keys[--left->count];
+  } else if (right != NULL && right->count > INNER_MIN) {
+    inner->keys[inner->count] = parent->keys[c];
+    inner->children[inner->count + 1] = right->children[0];
+    inner->count++;
+    parent->keys[c] = right->keys[0];
+    right->count--;
+    memmove(right->keys, right->keys + 1, right->count * sizeof(int));
+    memmove(right->children, right->children + 1, (right->count + 1) * sizeof(void*));
+  } else {
+    if (left != NULL) {
+      right = inner;
+      inner = left;
+      c--;
+    }
+    inner->keys[inner->count] = parent->keys[c];
+    memcpy(inner->keys + inner->count + 1, right->keys, right->count * sizeof(int));
+    memcpy(inner->children + inner->count + 1, right->children, (right->count + 1) * sizeof(void*));
+    inner->count += right->count + 1;
+    freeNode(b, right);
+    removeFromInner(parent, c);
+  }
+}
+
+int removeFromBTree(BTree b, int n) {
+  BInner* path[MAX_DEPTH];
+  int index[MAX_DEPTH];
+  BLeaf* leaf = findLeaf(b, n, path, index);
+  int i = countBelow(leaf->keys, leaf->count, n);
+  if (i == leaf->count || leaf->keys[i] != n) {
+    return 0;
+  }
+  b->size--;
+  leaf->count--;
+  memmove(leaf->keys + i, leaf->keys + i + 1, (leaf->count - i) * sizeof(int));
+  // separators equal to n may stay: they still separate correctly
+  int level = b->height - 2;
+  if (level < 0 || leaf->count >= LEAF_MIN) {
+    return 1;
+  }
+  fixLeaf(b, path[level], index[level]);
+  for (; level > 0 && path[level]->count < INNER_MIN; level--) {
+    fixInner(b, path[level - 1], index[level - 1]);
+  }
+  BInner* root = b->root;
+  if (root->count == 0) {
+    b->root = root->children[0];
+    b->height--;
+    freeNode(b, root);
+  }
+  return 1;
+}
+
+/*
+ * @brief Builds a tree from keys sorted in ascending order, skipping
+ * repeated keys, with the leaves as full as possible
+ */
+BTree bulkLoadBTree(const int* keys, long n) {
+  BTree b = newBTree();
+  long distinct = 0;
+  for (long i = 0; i < n; i++) {
+    assert(i == 0 || keys[i - 1] <= keys[i]);
+    distinct += i == 0 || keys[i] != keys[i - 1];
+  }
+  if (distinct == 0) {
+    return b;
+  }
+  // spread the keys evenly, so that every leaf is at least half full
+  long leaves = (distinct + LEAF_KEYS - 1) / LEAF_KEYS;
+  void** nodes = malloc(leaves * sizeof(void*));
+  int* mins = malloc(leaves * sizeof(int));
+  assert(nodes != NULL && mins != NULL);
+  long k = 0;
+  BLeaf* previous = NULL;
+  for (long j = 0; j < leaves; j++) {
+    BLeaf* leaf = j == 0 ? b->first : newLeaf(b);
+    int count = (int)(distinct / leaves + (j < distinct % leaves));
+    for (int i = 0; i < count; i++) {
+      while (k > 0 && keys[k] == keys[k - 1]) {
+        k++;
+      }
+      leaf->keys[i] = keys[k++];
+    }
+    leaf->count = count;
+    if (previous != NULL) {
+      previous->next = leaf;
+    }
+    previous = leaf;
+    nodes[j] = leaf;
+    mins[j] = leaf->keys[0];
+  }
+  // then each level of inner nodes over the one below, in place
+  long m = leaves;
+  while (m > 1) {
+    long groups = (m + INNER_KEYS) / (INNER_KEYS + 1);
+    long first = 0;
+    for (long g = 0; g < groups; g++) {
+      int count = (int)(m / groups + (g < m % groups));
+      BInner* inner = newInner(b);
+      inner->count = count - 1;
+      memcpy(inner->children, nodes + first, count * sizeof(void*));
+      memcpy(inner->keys, mins + first + 1, (count - 1) * sizeof(int));
+      nodes[g] = inner;
+      mins[g] = mins[first];
+      first += count;
+    }
+    m = groups;
+    b->height++;
+  }
+  b->root = nodes[0];
+  b->size = distinct;
+  free(nodes);
+  free(mins);
+  return b;
+}
+
+long rangeBTree(BTree b, int low, int high, int* out, long max) {
+  if (low > high) {
+    return 0;
+  }
+  BLeaf* leaf = findLeaf(b, low, NULL, NULL);
+  int i = countBelow(leaf->keys, leaf->count, low);
+  long found = 0;
+  while (leaf != NULL) {
+    for (; i < leaf->count; i++) {
+      if (leaf->keys[i] > high || found == max) {
+        return found;
+      }
+      if (out != NULL) {
+        out[found] = leaf->keys[i];
+      }
+      found++;
+    }
+    leaf = leaf->next;
+    i = 0;
+  }
+  return found;
+}
+
+void inOrderBTree(BTree b) {
+  for (BLeaf* leaf = b->first; leaf != NULL; leaf = leaf->next) {
+    for (int i = 0; i < leaf->count; i++) {
+      printf("%d\n", leaf->keys[i]);
+    }
+  }
+}
+
+/*
+ * @brief Frees the tree with one free per chunk of nodes
+ */
+void freeBTree(BTree b) {
+  BChunk* chunk = b->chunks;
+  while (chunk != NULL) {
+    BChunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  free(b);
+}
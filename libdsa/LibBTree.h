@@ -0,0 +1,37 @@
+#ifndef LIBBTREE_H
+#define LIBBTREE_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Ordered set of ints in a B+-tree of 512-byte nodes: leaves hold up to
+ * 120 keys and are linked in order, inner nodes hold up to 40 keys and
+ * 41 children. A search misses the cache a few times per level instead
+ * of once per key like a Tree, and a tree of 10^8 keys has 5 levels.
+ * Keys within a node are compared with SSE2 or AVX2 when the library is
+ * built for them. Every node but the root is at least half full, and
+ * nodes come from 64 KiB chunks owned by the tree.
+ *
+ * addInBTree and removeFromBTree follow addInSearchTree and
+ * removeInSearchTree: adding a key that is there, or removing one that
+ * is not, changes nothing.
+ */
+typedef struct BTreeS* BTree;
+
+BTree newBTree(void);
+BTree bulkLoadBTree(const int* keys, long n);
+
+long sizeBTree(BTree b);
+int heightBTree(BTree b);
+size_t bytesBTree(BTree b);
+int addInBTree(BTree b, int n);
+int searchBTree(BTree b, int n);
+int removeFromBTree(BTree b, int n);
+long rangeBTree(BTree b, int low, int high, int* out, long max);
+void inOrderBTree(BTree b);
+void freeBTree(BTree b);
+
+#endif
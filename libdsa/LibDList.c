@@ -0,0 +1,290 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDList.h"
+#include "LibList.h"
+
+#define CHUNK_NODES 1024 /* nodes are allocated this many at a time */
+
+/*
+ * The index is an open-addressing hash table with linear probing from
+ * each value to its first and last node; a slot with first == NULL is
+ * empty. It doubles when half full, and a removed value shifts later
+ * slots back instead of leaving a tombstone.
+ */
+typedef struct Slot {
+  int item;
+  int count;
+  DNode* first;
+  DNode* last;
+} Slot;
+
+typedef struct DChunk {
+  struct DChunk* next;
+  DNode nodes[CHUNK_NODES];
+} DChunk;
+
+typedef struct DListS {
+  DNode* head;
+  DNode* tail;
+  int length;
+  Slot* slots;
+  size_t capacity;  // a power of two
+  size_t used;
+  DChunk* chunks;
+  DNode* freeNodes;  // linked through next
+  int fresh;         // unused nodes of chunks, from this one on
+} DListS;
+
+static const size_t MIN_INDEX_SIZE = 16;
+
+static size_t slotOf(int n, size_t capacity) {
+  // Fibonacci hashing: the top bits of the product are well mixed
+  return (size_t)(((uint64_t)(uint32_t)n * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+static Slot* findSlot(DList d, int n) {
+  size_t i = slotOf(n, d->capacity);
+  while (d->slots[i].first != NULL && d->slots[i].item != n) {
+    i = (i + 1) & (d->capacity - 1);
+  }
+  return &d->slots[i];
+}
+
+static void growIndex(DList d) {
+  Slot* old = d->slots;
+  size_t oldCapacity = d->capacity;
+  d->capacity *= 2;
+  d->slots = calloc(d->capacity, sizeof(Slot));
+  assert(d->slots != NULL);
+  for (size_t i = 0; i < oldCapacity; i++) {
+    if (old[i].first != NULL) {
+      *findSlot(d, old[i].item) = old[i];
+    }
+  }
+  free(old);
+}
+
+static void removeSlot(DList d, Slot* slot) {
+  size_t i = slot - d->slots;
+  size_t j = i;
+  for (;;) {
+    j = (j + 1) & (d->capacity - 1);
+    if (d->slots[j].first == NULL) {
+      break;
+    }
+    // move slot j back to the hole at i if its home is not in (i, j]
+    size_t home = slotOf(d->slots[j].item, d->capacity);
+    if (((j - home) & (d->capacity - 1)) >= ((j - i) & (d->capacity - 1))) {
+      d->slots[i] = d->slots[j];
+      i = j;
+    }
+  }
+  d->slots[i].first = NULL;
+  d->used--;
+}
+
+DList newDList(void) {
+  DList d = calloc(1, sizeof(DListS));
+  assert(d != NULL);
+  d->capacity = MIN_INDEX_SIZE;
+  d->slots = calloc(d->capacity, sizeof(Slot));
+  assert(d->slots != NULL);
+  d->fresh = CHUNK_NODES;
+  return d;
+}
+
+int isEmptyDList(DList d) {
+  return d->length == 0;
+}
+
+int lengthDList(DList d) {
+  return d->length;
+}
+
+static DNode* newNode(DList d, int n) {
+  DNode* node = d->freeNodes;
+  if (node != NULL) {
+    d->freeNodes = node->next;
+  } else {
+    if (d->fresh == CHUNK_NODES) {
+      DChunk* chunk = malloc(sizeof(DChunk));
+      assert(chunk != NULL);
+      chunk->next = d->chunks;
+      d->chunks = chunk;
+      d->fresh = 0;
+    }
+    node = &d->chunks->nodes[d->fresh++];
+  }
+  node->item = n;
+  return node;
+}
+
+/*
+ * @brief Links node into the index as the first (atFront) or last
+ * occurrence of its item
+ */
+static void indexNode(DList d, DNode* node, int atFront) {
+  if (2 * (d->used + 1) > d->capacity) {
+    growIndex(d);
+  }
+  Slot* slot = findSlot(d, node->item);
+  node->prevSame = node->nextSame = NULL;
+  if (slot->first == NULL) {
+    slot->item = node->item;
+    slot->count = 1;
+    slot->first = slot->last = node;
+    d->used++;
+  } else if (atFront) {
+    node->nextSame = slot->first;
+    slot->first->prevSame = node;
+    slot->first = node;
+    slot->count++;
+  } else {
+    node->prevSame = slot->last;
+    slot->last->nextSame = node;
+    slot->last = node;
+    slot->count++;
+  }
+}
+
+void pushFrontDList(int n, DList d) {
+  DNode* node = newNode(d, n);
+  node->prev = NULL;
+  node->next = d->head;
+  if (d->head != NULL) {
+    d->head->prev = node;
+  } else {
+    d->tail = node;
+  }
+  d->head = node;
+  d->length++;
+  indexNode(d, node, 1);
+}
+
+void pushBackDList(int n, DList d) {
+  DNode* node = newNode(d, n);
+  node->next = NULL;
+  node->prev = d->tail;
+  if (d->tail != NULL) {
+    d->tail->next = node;
+  } else {
+    d->head = node;
+  }
+  d->tail = node;
+  d->length++;
+  indexNode(d, node, 0);
+}
+
+/*
+ * @brief Unlinks node from the list and from the index, and frees it
+ */
+static void removeNode(DList d, DNode* node, Slot* slot) {
+  if (node->prev != NULL) {
+    node->prev->next = node->next;
+  } else {
+    d->head = node->next;
+  }
+  if (node->next != NULL) {
+    node->next->prev = node->prev;
+  } else {
+    d->tail = node->prev;
+  }
+  d->length--;
+  if (--slot->count == 0) {
+    removeSlot(d, slot);
+  } else {
+    if (node->prevSame != NULL) {
+      node->prevSame->nextSame = node->nextSame;
+    } else {
+      slot->first = node->nextSame;
+    }
+    if (node->nextSame != NULL) {
+      node->nextSame->prevSame = node->prevSame;
+    } else {
+      slot->last = node->prevSame;
+    }
+  }
+  node->next = d->freeNodes;
+  d->freeNodes = node;
+}
+
+int popFrontDList(DList d) {
+  if (d->head == NULL) {
+    listEmptyError();
+  }
+  int n = d->head->item;
+  removeNode(d, d->head, findSlot(d, n));
+  return n;
+}
+
+int popBackDList(DList d) {
+  if (d->tail == NULL) {
+    listEmptyError();
+  }
+  int n = d->tail->item;
+  removeNode(d, d->tail, findSlot(d, n));
+  return n;
+}
+
+int isInDList(int n, DList d) {
+  return findSlot(d, n)->first != NULL;
+}
+
+int countInDList(int n, DList d) {
+  Slot* slot = findSlot(d, n);
+  return slot->first != NULL ? slot->count : 0;
+}
+
+/*
+ * @brief Removes the first occurrence of n
+ * @return 1 if n was in the list, 0 if not
+ */
+int removeFirstDList(int n, DList d) {
+  Slot* slot = findSlot(d, n);
+  if (slot->first == NULL) {
+    return 0;
+  }
+  removeNode(d, slot->first, slot);
+  return 1;
+}
+
+/*
+ * @brief Removes the last occurrence of n
+ * @return 1 if n was in the list, 0 if not
+ */
+int removeLastDList(int n, DList d) {
+  Slot* slot = findSlot(d, n);
+  if (slot->first == NULL) {
+    return 0;
+  }
+  removeNode(d, slot->last, slot);
+  return 1;
+}
+
+DNode* firstDList(DList d) {
+  return d->head;
+}
+
+DNode* lastDList(DList d) {
+  return d->tail;
+}
+
+void printDList(DList d) {
+  for (DNode* p = d->head; p != NULL; p = p->next) {
+    printf("%d ", p->item);
+  }
+}
+
+void freeDList(DList d) {
+  DChunk* chunk = d->chunks;
+  while (chunk != NULL) {
+    DChunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  free(d->slots);
+  free(d);
+}
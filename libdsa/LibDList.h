@@ -0,0 +1,41 @@
+#ifndef LIBDLIST_H
+#define LIBDLIST_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Doubly linked list of ints with a hash index from each value to the
+ * nodes holding it, in list order. Adding at either end, removing the
+ * first or last occurrence of a value, and membership tests are O(1)
+ * expected, instead of a scan of the list.
+ */
+typedef struct DNode {
+  int item;
+  struct DNode* prev;
+  struct DNode* next;
+  struct DNode* prevSame;  // the occurrences of item, in list order
+  struct DNode* nextSame;
+} DNode;
+
+typedef struct DListS* DList;
+
+DList newDList(void);
+
+int isEmptyDList(DList d);
+int lengthDList(DList d);
+void pushFrontDList(int n, DList d);
+void pushBackDList(int n, DList d);
+int popFrontDList(DList d);
+int popBackDList(DList d);
+int isInDList(int n, DList d);
+int countInDList(int n, DList d);
+int removeFirstDList(int n, DList d);
+int removeLastDList(int n, DList d);
+DNode* firstDList(DList d);
+DNode* lastDList(DList d);
+void printDList(DList d);
+void freeDList(DList d);
+
+#endif
@@ -0,0 +1,185 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "LibDeque.h"
+
+#define BLOCK_ITEMS 1024 /* 4 KiB blocks */
+#define POOL_BLOCKS 4    /* empty blocks kept for reuse */
+
+/*
+ * The items occupy the positions begin .. end-1 of a virtual array; the
+ * item at position p lives in map[p / BLOCK_ITEMS][p % BLOCK_ITEMS]. Only
+ * the blocks that hold items are allocated. When the map runs out of
+ * slots at one end, the block pointers are re-centred (and the map grows
+ * if more than half full), but the blocks themselves never move.
+ */
+typedef struct DequeS {
+  int** map;
+  size_t mapSize;
+  size_t begin;
+  size_t end;
+  int* pool[POOL_BLOCKS];
+  int poolSize;
+} DequeS;
+
+static const size_t INITIAL_MAP_SIZE = 8;
+
+Deque newDeque(void) {
+  Deque d = malloc(sizeof(DequeS));
+  assert(d != NULL);
+  d->mapSize = INITIAL_MAP_SIZE;
+  d->map = calloc(d->mapSize, sizeof(int*));
+  assert(d->map != NULL);
+  d->begin = d->end = (d->mapSize / 2) * BLOCK_ITEMS + BLOCK_ITEMS / 2;
+  d->poolSize = 0;
+  return d;
+}
+
+int isEmptyDeque(Deque d) {
+  return (d->begin == d->end);
+}
+
+int lengthDeque(Deque d) {
+  return d->end - d->begin;
+}
+
+void dequeEmptyError(void) {
+  printf("deque empty\n");
+  abort();
+}
+
+int* newBlock(Deque d) {
+  if (d->poolSize > 0) {
+    d->poolSize--;
+    return d->pool[d->poolSize];
+  }
+  int* block = malloc(BLOCK_ITEMS * sizeof(int));
+  assert(block != NULL);
+  return block;
+}
+
+void releaseBlock(Deque d, size_t b) {
+  if (d->poolSize < POOL_BLOCKS) {
+    d->pool[d->poolSize] = d->map[b];
+    d->poolSize++;
+  } else {
+    free(d->map[b]);
+  }
+  d->map[b] = NULL;
+}
+
+/* the last item was removed: start again from the middle of the map */
+void recentre(Deque d) {
+  d->begin = d->end = (d->mapSize / 2) * BLOCK_ITEMS + BLOCK_ITEMS / 2;
+}
+
+/* makes room for one more block at both ends of the used part of the map */
+void adjustMap(Deque d) {
+  size_t lo = d->begin / BLOCK_ITEMS;
+  size_t used = (d->end - 1) / BLOCK_ITEMS - lo + 1;
+  size_t newSize = d->mapSize;
+  while (used + 2 > newSize / 2) {
+    newSize *= 2;
+  }
+  if (newSize != d->mapSize) {
+    d->map = realloc(d->map, newSize * sizeof(int*));
+    assert(d->map != NULL);
+    memset(d->map + d->mapSize, 0, (newSize - d->mapSize) * sizeof(int*));
+    d->mapSize = newSize;
+  }
+  size_t newLo = (d->mapSize - used) / 2;
+  memmove(d->map + newLo, d->map + lo, used * sizeof(int*));
+  if (newLo > lo) {
+    memset(d->map + lo, 0, (newLo - lo < used ? newLo - lo : used) * sizeof(int*));
+  } else if (newLo < lo) {
+    size_t from = newLo + used > lo ? newLo + used : lo;
+    memset(d->map + from, 0, (lo + used - from) * sizeof(int*));
+  }
+  d->begin = d->begin - lo * BLOCK_ITEMS + newLo * BLOCK_ITEMS;
+  d->end = d->end - lo * BLOCK_ITEMS + newLo * BLOCK_ITEMS;
+}
+
+void pushBack(int item, Deque d) {
+  if (isEmptyDeque(d) || d->end % BLOCK_ITEMS == 0) {
+    if (d->end == d->mapSize * BLOCK_ITEMS) {
+      adjustMap(d);
+    }
+    if (isEmptyDeque(d) || d->end % BLOCK_ITEMS == 0) {
+      d->map[d->end / BLOCK_ITEMS] = newBlock(d);
+    }
+  }
+  d->map[d->end / BLOCK_ITEMS][d->end % BLOCK_ITEMS] = item;
+  d->end++;
+}
+
+void pushFront(int item, Deque d) {
+  if (isEmptyDeque(d) || d->begin % BLOCK_ITEMS == 0) {
+    if (d->begin == 0) {
+      adjustMap(d);
+    }
+    if (isEmptyDeque(d) || d->begin % BLOCK_ITEMS == 0) {
+      d->map[(d->begin - 1) / BLOCK_ITEMS] = newBlock(d);
+    }
+  }
+  d->begin--;
+  d->map[d->begin / BLOCK_ITEMS][d->begin % BLOCK_ITEMS] = item;
+}
+
+int popFront(Deque d) {
+  if (isEmptyDeque(d)) {
+    dequeEmptyError();
+  }
+  int item = d->map[d->begin / BLOCK_ITEMS][d->begin % BLOCK_ITEMS];
+  d->begin++;
+  if (isEmptyDeque(d) || d->begin % BLOCK_ITEMS == 0) {
+    releaseBlock(d, (d->begin - 1) / BLOCK_ITEMS);
+  }
+  if (isEmptyDeque(d)) {
+    recentre(d);
+  }
+  return item;
+}
+
+int popBack(Deque d) {
+  if (isEmptyDeque(d)) {
+    dequeEmptyError();
+  }
+  d->end--;
+  int item = d->map[d->end / BLOCK_ITEMS][d->end % BLOCK_ITEMS];
+  if (isEmptyDeque(d) || d->end % BLOCK_ITEMS == 0) {
+    releaseBlock(d, d->end / BLOCK_ITEMS);
+  }
+  if (isEmptyDeque(d)) {
+    recentre(d);
+  }
+  return item;
+}
+
+int peekFront(Deque d) {
+  if (isEmptyDeque(d)) {
+    dequeEmptyError();
+  }
+  return d->map[d->begin / BLOCK_ITEMS][d->begin % BLOCK_ITEMS];
+}
+
+int peekBack(Deque d) {
+  if (isEmptyDeque(d)) {
+    dequeEmptyError();
+  }
+  return d->map[(d->end - 1) / BLOCK_ITEMS][(d->end - 1) % BLOCK_ITEMS];
+}
+
+void freeDeque(Deque d) {
+  if (!isEmptyDeque(d)) {
+    for (size_t b = d->begin / BLOCK_ITEMS; b <= (d->end - 1) / BLOCK_ITEMS; b++) {
+      free(d->map[b]);
+    }
+  }
+  for (int i = 0; i < d->poolSize; i++) {
+    free(d->pool[i]);
+  }
+  free(d->map);
+  free(d);
+}
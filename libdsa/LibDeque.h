@@ -0,0 +1,27 @@
+#ifndef LIBDEQUE_H
+#define LIBDEQUE_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Double-ended queue of ints stored in fixed-size blocks. Pushing and
+ * popping at either end is O(1), and growing never moves stored items.
+ */
+typedef struct DequeS* Deque;
+
+Deque newDeque(void);
+
+void pushFront(int item, Deque d);
+void pushBack(int item, Deque d);
+int popFront(Deque d);
+int popBack(Deque d);
+int peekFront(Deque d);
+int peekBack(Deque d);
+
+int isEmptyDeque(Deque d);
+int lengthDeque(Deque d);
+void freeDeque(Deque d);
+
+#endif
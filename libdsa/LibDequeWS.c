@@ -0,0 +1,140 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDequeWS.h"
+
+#define CACHE_LINE 64
+
+/*
+ * The items are at positions top .. bottom-1, position p in slot
+ * p & mask of the current array. Only the owner changes bottom and the
+ * array; top only moves up, by a CAS of whoever takes the item at top
+ * (a thief, or the owner popping the very last item). The memory orders
+ * follow Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * A thief may still be reading an array that the owner has just
+ * replaced, so replaced arrays are kept until the deque is freed. They
+ * add up to less than the final array.
+ */
+typedef struct Array {
+  size_t mask;
+  struct Array* previous;
+  atomic_int items[];
+} Array;
+
+typedef struct DequeWSS {
+  _Alignas(CACHE_LINE) atomic_size_t top;
+  _Alignas(CACHE_LINE) atomic_size_t bottom;
+  _Atomic(Array*) array;
+} DequeWSS;
+
+Array* newArray(size_t size, Array* previous) {
+  Array* a = malloc(sizeof(Array) + size * sizeof(atomic_int));
+  assert(a != NULL);
+  a->mask = size - 1;
+  a->previous = previous;
+  return a;
+}
+
+DequeWS newDequeWS(int capacity) {
+  // a power of two, 2 for a capacity of 0 or less and at most 2^31 (above INT_MAX)
+  size_t size = 2;
+  while (capacity > 0 && size < (size_t)capacity) {
+    size *= 2;
+  }
+  DequeWS d = aligned_alloc(CACHE_LINE, sizeof(DequeWSS));
+  assert(d != NULL);
+  atomic_init(&d->top, 0);
+  atomic_init(&d->bottom, 0);
+  atomic_init(&d->array, newArray(size, NULL));
+  return d;
+}
+
+/* owner only: copy the items to an array twice the size */
+Array* growDequeWS(DequeWS d, Array* a, size_t top, size_t bottom) {
+  Array* bigger = newArray(2 * (a->mask + 1), a);
+  for (size_t p = top; p < bottom; p++) {
+    int item = atomic_load_explicit(&a->items[p & a->mask], memory_order_relaxed);
+    atomic_store_explicit(&bigger->items[p & bigger->mask], item, memory_order_relaxed);
+  }
+  /* release: a thief that sees the new array also sees its items */
+  atomic_store_explicit(&d->array, bigger, memory_order_release);
+  return bigger;
+}
+
+void pushDequeWS(int item, DequeWS d) {
+  size_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+  size_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+  Array* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+  if (b - t > a->mask) {
+    a = growDequeWS(d, a, t, b);
+  }
+  atomic_store_explicit(&a->items[b & a->mask], item, memory_order_relaxed);
+  /* release: a thief that sees the new bottom also sees the item */
+  atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+}
+
+int popDequeWS(int* item, DequeWS d) {
+  size_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+  if (b == atomic_load_explicit(&d->top, memory_order_relaxed)) {
+    return 0; /* cheap exit; top only grows, so the deque stays empty for the owner */
+  }
+  b--;
+  Array* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+  atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+  /* the reservation of position b must be visible before we read top */
+  atomic_thread_fence(memory_order_seq_cst);
+  size_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+  int taken;
+  if (t < b) {
+    /* more than one item: no thief can reach position b */
+    *item = atomic_load_explicit(&a->items[b & a->mask], memory_order_relaxed);
+    return 1;
+  }
+  if (t == b) {
+    /* the last item: race the thieves for it by moving top */
+    *item = atomic_load_explicit(&a->items[b & a->mask], memory_order_relaxed);
+    taken = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+  } else {
+    taken = 0; /* a thief took the last item before our reservation */
+  }
+  atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+  return taken;
+}
+
+int stealDequeWS(int* item, DequeWS d) {
+  size_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  size_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+  if (t >= b) {
+    return 0; /* empty, or the owner is about to pop the last item */
+  }
+  Array* a = atomic_load_explicit(&d->array, memory_order_acquire);
+  int x = atomic_load_explicit(&a->items[t & a->mask], memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+    return 0; /* lost the race with another thief or the owner */
+  }
+  *item = x;
+  return 1;
+}
+
+/* only a snapshot while other threads are active */
+int isEmptyDequeWS(DequeWS d) {
+  size_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+  size_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+  return t >= b;
+}
+
+void freeDequeWS(DequeWS d) {
+  Array* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+  while (a != NULL) {
+    Array* previous = a->previous;
+    free(a);
+    a = previous;
+  }
+  free(d);
+}
@@ -0,0 +1,27 @@
+#ifndef LIBDEQUEWS_H
+#define LIBDEQUEWS_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Chase-Lev work-stealing deque of ints. One owner thread uses the bottom
+ * like a LibStack (push and pop, LIFO); any number of thief threads take
+ * the oldest items from the top. The circular array grows when full.
+ */
+typedef struct DequeWSS* DequeWS;
+
+DequeWS newDequeWS(int capacity);
+
+/* owner only */
+void pushDequeWS(int item, DequeWS d);
+int popDequeWS(int* item, DequeWS d);
+
+/* any thread; returns 0 when the deque was empty or another thread won the race */
+int stealDequeWS(int* item, DequeWS d);
+
+int isEmptyDequeWS(DequeWS d);
+void freeDequeWS(DequeWS d);
+
+#endif
@@ -0,0 +1,452 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibList.h"
+
+// slabs are aligned to their size, so the slab of a node is found by
+// masking its address
+#define LIST_SLAB_SIZE 65536
+#define INITIAL_SLAB_SET 16
+
+/*
+ * A pool records the addresses of its slabs in a hash set (open
+ * addressing, 0 marks a free entry), so freeNode can tell its nodes from
+ * malloc'ed ones without a field in the node.
+ */
+struct ListPool {
+  uintptr_t* slabs;
+  size_t slabCapacity;  // a power of two, at least twice slabCount
+  size_t slabCount;
+  List freeNodes;  // given back, linked through next
+  List fresh;      // never used nodes of the newest slab
+  List freshEnd;
+};
+
+static _Thread_local ListPool* currentPool;  // NULL: malloc and free
+
+static size_t slabHash(uintptr_t slab, size_t capacity) {
+  return (size_t)(((uint64_t)(slab / LIST_SLAB_SIZE) * 0x9E3779B97F4A7C15u) >> 32) & (capacity - 1);
+}
+
+static void insertSlab(uintptr_t* set, size_t capacity, uintptr_t slab) {
+  size_t i = slabHash(slab, capacity);
+  while (set[i] != 0) {
+    i = (i + 1) & (capacity - 1);
+  }
+  set[i] = slab;
+}
+
+static void addSlab(ListPool* pool, uintptr_t slab) {
+  if (2 * (pool->slabCount + 1) > pool->slabCapacity) {
+    size_t capacity = 2 * pool->slabCapacity;
+    uintptr_t* set = calloc(capacity, sizeof(uintptr_t));
+    assert(set != NULL);
+    for (size_t i = 0; i < pool->slabCapacity; i++) {
+      if (pool->slabs[i] != 0) {
+        insertSlab(set, capacity, pool->slabs[i]);
+      }
+    }
+    free(pool->slabs);
+    pool->slabs = set;
+    pool->slabCapacity = capacity;
+  }
+  insertSlab(pool->slabs, pool->slabCapacity, slab);
+  pool->slabCount++;
+}
+
+static int ownsNode(ListPool* pool, List node) {
+  uintptr_t slab = (uintptr_t)node & ~(uintptr_t)(LIST_SLAB_SIZE - 1);
+  for (size_t i = slabHash(slab, pool->slabCapacity); pool->slabs[i] != 0; i = (i + 1) & (pool->slabCapacity - 1)) {
+    if (pool->slabs[i] == slab) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+ListPool* newListPool(void) {
+  ListPool* pool = calloc(1, sizeof(ListPool));
+  assert(pool != NULL);
+  pool->slabCapacity = INITIAL_SLAB_SET;
+  pool->slabs = calloc(pool->slabCapacity, sizeof(uintptr_t));
+  assert(pool->slabs != NULL);
+  return pool;
+}
+
+/*
+ * @brief Makes addItem take nodes from pool (NULL: malloc them)
+ * @return The pool used before
+ */
+ListPool* useListPool(ListPool* pool) {
+  ListPool* previous = currentPool;
+  currentPool = pool;
+  return previous;
+}
+
+/*
+ * @brief Frees every list built from pool, and pool itself
+ */
+void freeListPool(ListPool* pool) {
+  for (size_t i = 0; i < pool->slabCapacity; i++) {
+    free((void*)pool->slabs[i]);
+  }
+  free(pool->slabs);
+  if (currentPool == pool) {
+    currentPool = NULL;
+  }
+  free(pool);
+}
+
+static List newNode(void) {
+  ListPool* pool = currentPool;
+  List node;
+  if (pool == NULL) {
+    node = malloc(sizeof(struct ListNode));
+    assert(node != NULL);
+    return node;
+  }
+  node = pool->freeNodes;
+  if (node != NULL) {
+    pool->freeNodes = node->next;
+    return node;
+  }
+  if (pool->fresh == pool->freshEnd) {
+    List slab = aligned_alloc(LIST_SLAB_SIZE, LIST_SLAB_SIZE);
+    assert(slab != NULL);
+    addSlab(pool, (uintptr_t)slab);
+    pool->fresh = slab;
+    pool->freshEnd = slab + LIST_SLAB_SIZE / sizeof(struct ListNode);
+  }
+  return pool->fresh++;
+}
+
+static void freeNode(List node) {
+  ListPool* pool = currentPool;
+  if (pool != NULL && ownsNode(pool, node)) {
+    node->next = pool->freeNodes;
+    pool->freeNodes = node;
+  } else {
+    free(node);
+  }
+}
+
+List newEmptyList(void) {
+  return NULL;
+}
+
+int isEmptyList(List li) {
+  return (li == NULL);
+}
+
+void listEmptyError(void) {
+  printf("list empty\n");
+  abort();
+}
+
+List addItem(int n, List li) {
+  List newList = newNode();
+  newList->item = n;
+  newList->next = li;
+  return newList;
+}
+
+int firstItem(List li) {
+  if (li == NULL) {
+    listEmptyError();
+  }
+  return li->item;
+}
+
+List removeFirstNode(List li) {
+  if (li == NULL) {
+    listEmptyError();
+  }
+  List returnList = li->next;
+  freeNode(li);
+  return returnList;
+}
+
+void freeList(List li) {
+  List li1;
+  while (li != NULL) {
+    li1 = li->next;
+    freeNode(li);
+    li = li1;
+  }
+  return;
+}
+
+void printList(List li) {
+  while (li != NULL) {
+    printf("%d ", li->item);
+    li = li->next;
+  }
+}
+
+void printListRec(List li) {
+  if (li == NULL) {
+    return;
+  }
+  printf("%d ", li->item);
+  printListRec(li->next);
+}
+
+void listTooShort(void) {
+  printf("List too short\n");
+  abort();
+}
+
+int itemAtPos(List li, int p) {
+  while (li != NULL && p > 0) {
+    li = li->next;
+    p--;
+  }
+  if (li == NULL || p < 0) {
+    listTooShort();
+  }
+  return li->item;
+}
+
+/* iterative, so long lists do not overflow the stack */
+List addItemAtPos(List li, int n, int p) {
+  return addItemAtPosIt(li, n, p);
+}
+
+List addItemAtPosIt(List li, int n, int p) {
+  if (p < 0) {
+    listTooShort();
+  }
+  if (p == 0) {
+    return addItem(n, li);
+  }
+  List li1 = li;
+  while (li1 != NULL && p > 1) {
+    li1 = li1->next;
+    p--;
+  }
+  if (li1 == NULL) {
+    listTooShort();
+  }
+  /* now li1 points to the node on position p-1 */
+  li1->next = addItem(n, li1->next);
+  return li;
+}
+
+List removeItem(List li, int n) {
+  return removeItemIt(li, n);
+}
+
+List removeItemIt(List li, int n) {
+  if (li == NULL) {
+    return li;
+  }
+  if (li->item == n) {
+    return removeFirstNode(li);
+  }
+  List li1 = li;
+  while (li1->next != NULL && (li1->next)->item != n) {
+    li1 = li1->next;
+  }
+  if (li1->next != NULL) { /* so (li1->next)->item == n */
+    li1->next = removeFirstNode(li1->next);
+  }
+  return li;  // not li1
+}
+
+/*
+ * @brief Merges two sorted lists by relinking; on ties a comes first
+ */
+static List mergeLists(List a, List b) {
+  struct ListNode head;
+  List tail = &head;
+  while (a != NULL && b != NULL) {
+    if (b->item < a->item) {
+      tail->next = b;
+      b = b->next;
+    } else {
+      tail->next = a;
+      a = a->next;
+    }
+    tail = tail->next;
+  }
+  tail->next = (a != NULL) ? a : b;
+  return head.next;
+}
+
+/*
+ * @brief Cuts the longest ascending, or strictly descending, run off the
+ * front of *rest and returns it in ascending order
+ */
+static List takeRun(List* rest) {
+  List run = *rest;
+  List p = run;
+  if (p->next != NULL && p->next->item < p->item) {
+    // strictly descending, so reversing keeps equal items in order
+    List reversed = NULL;
+    List last;
+    do {
+      last = p;
+      p = p->next;
+      last->next = reversed;
+      reversed = last;
+    } while (p != NULL && p->item < last->item);
+    *rest = p;
+    return reversed;
+  }
+  while (p->next != NULL && p->next->item >= p->item) {
+    p = p->next;
+  }
+  *rest = p->next;
+  p->next = NULL;
+  return run;
+}
+
+/*
+ * @brief Stable natural merge sort, by relinking the nodes
+ *
+ * The runs already in the list are merged bottom-up: pending[i] holds
+ * the merge of 2^i runs, and each new run is carried up like a bit added
+ * to a binary counter. This takes O(n log r) time for r runs (O(n) on
+ * sorted or reversed input), no recursion and no allocation.
+ */
+List sortList(List li) {
+  List pending[8 * sizeof(long)] = {NULL};
+  int levels = 0;
+  while (li != NULL) {
+    List run = takeRun(&li);
+    int i = 0;
+    while (pending[i] != NULL) {
+      run = mergeLists(pending[i], run);  // pending[i] came earlier
+      pending[i] = NULL;
+      i++;
+    }
+    pending[i] = run;
+    if (i >= levels) {
+      levels = i + 1;
+    }
+  }
+  List sorted = NULL;
+  for (int i = 0; i < levels; i++) {
+    if (pending[i] != NULL) {
+      sorted = mergeLists(pending[i], sorted);
+    }
+  }
+  return sorted;
+}
+
+/*
+ * @brief Stable sort through an array: the items and node numbers are
+ * radix sorted a byte at a time, then the nodes are relinked in order
+ *
+ * Faster than sortList on long lists in random order, but it needs 24
+ * bytes per node; if those cannot be allocated (or there are 2^32 nodes
+ * or more) it falls back to sortList.
+ */
+List sortListRadix(List li) {
+  size_t n = 0;
+  for (List p = li; p != NULL; p = p->next) {
+    n++;
+  }
+  if (n < 2 || n > UINT32_MAX) {
+    return sortList(li);
+  }
+  List* nodes = malloc(n * sizeof(List));
+  uint64_t* keys = malloc(n * sizeof(uint64_t));
+  uint64_t* buffer = malloc(n * sizeof(uint64_t));
+  if (nodes == NULL || keys == NULL || buffer == NULL) {
+    free(nodes);
+    free(keys);
+    free(buffer);
+    return sortList(li);
+  }
+  // the item (sign bit flipped, so the order is unsigned) in the high
+  // half, the node number in the low half
+  size_t i = 0;
+  for (List p = li; p != NULL; p = p->next, i++) {
+    nodes[i] = p;
+    keys[i] = (uint64_t)((uint32_t)p->item ^ 0x80000000u) << 32 | i;
+  }
+  for (int shift = 32; shift < 64; shift += 8) {
+    size_t count[257] = {0};
+    for (i = 0; i < n; i++) {
+      count[((keys[i] >> shift) & 0xff) + 1]++;
+    }
+    if (count[((keys[0] >> shift) & 0xff) + 1] == n) {
+      continue;  // all items have the same byte here
+    }
+    for (int b = 0; b < 256; b++) {
+      count[b + 1] += count[b];
+    }
+    for (i = 0; i < n; i++) {
+      buffer[count[(keys[i] >> shift) & 0xff]++] = keys[i];
+    }
+    uint64_t* swap = keys;
+    keys = buffer;
+    buffer = swap;
+  }
+  for (i = 0; i + 1 < n; i++) {
+    nodes[(uint32_t)keys[i]]->next = nodes[(uint32_t)keys[i + 1]];
+  }
+  nodes[(uint32_t)keys[n - 1]]->next = NULL;
+  li = nodes[(uint32_t)keys[0]];
+  free(nodes);
+  free(keys);
+  free(buffer);
+  return li;
+}
+
+ListHandle newListHandle(void) {
+  ListHandle h = malloc(sizeof(ListHandleS));
+  assert(h != NULL);
+  h->head = h->tail = NULL;
+  h->length = 0;
+  return h;
+}
+
+ListHandle listFromArray(int* arr, int n) {
+  ListHandle h = newListHandle();
+  for (int i = 0; i < n; i++) {
+    appendItem(arr[i], h);
+  }
+  return h;
+}
+
+void appendItem(int n, ListHandle h) {
+  List node = addItem(n, NULL);
+  if (h->tail == NULL) {
+    h->head = node;
+  } else {
+    h->tail->next = node;
+  }
+  h->tail = node;
+  h->length++;
+}
+
+void prependItem(int n, ListHandle h) {
+  h->head = addItem(n, h->head);
+  if (h->tail == NULL) {
+    h->tail = h->head;
+  }
+  h->length++;
+}
+
+int lengthHandle(ListHandle h) {
+  return h->length;
+}
+
+/*
+ * @brief Frees the handle but not its list, and returns the list
+ */
+List detachList(ListHandle h) {
+  List li = h->head;
+  free(h);
+  return li;
+}
+
+void freeListHandle(ListHandle h) {
+  freeList(detachList(h));
+}
@@ -0,0 +1,77 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#ifndef LIBLIST_H
+#define LIBLIST_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct ListNode* List;
+
+struct ListNode {
+  int item;
+  List next;
+};
+
+/*
+ * A list together with its last node and its length, for O(1) appends
+ * and lengths. head is an ordinary List, but changing it with the List
+ * functions does not update tail and length: after that, only
+ * detachList may be used on the handle.
+ */
+typedef struct ListHandleS {
+  List head;
+  List tail;
+  int length;
+} ListHandleS;
+
+typedef ListHandleS* ListHandle;
+
+/*
+ * addItem mallocs each node, unless the calling thread selected a pool
+ * with useListPool: then every List function that adds nodes takes them
+ * from that pool's 64 KiB slabs and its free list. removeFirstNode and
+ * freeList give a node of the selected pool back to it and free any
+ * other node, including nodes allocated by hand. freeListPool releases
+ * every node of a pool at once, one free per slab.
+ *
+ * Nodes of a pool must be freed while that pool is selected, on the same
+ * thread, or left to freeListPool; the free list of a pool is not locked.
+ * Code that does not select a pool (most exercises) keeps plain malloc.
+ */
+typedef struct ListPool ListPool;
+
+ListPool* newListPool(void);
+ListPool* useListPool(ListPool* pool);
+void freeListPool(ListPool* pool);
+
+List newEmptyList(void);
+
+int isEmptyList(List li);
+void listEmptyError(void);
+List addItem(int n, List li);
+int firstItem(List li);
+List removeFirstNode(List li);
+void freeList(List li);
+void print(List li);
+void printList(List li);
+void printListRec(List li);
+void listTooShort(void);
+int itemAtPos(List li, int p);
+List addItemAtPos(List li, int n, int p);
+List addItemAtPosIt(List li, int n, int p);
+List removeItem(List li, int n);
+List removeItemIt(List li, int n);
+List sortList(List li);
+List sortListRadix(List li);
+
+ListHandle newListHandle(void);
+ListHandle listFromArray(int* arr, int n);
+void appendItem(int n, ListHandle h);
+void prependItem(int n, ListHandle h);
+int lengthHandle(ListHandle h);
+List detachList(ListHandle h);
+void freeListHandle(ListHandle h);
+
+#endif
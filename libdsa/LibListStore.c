@@ -0,0 +1,206 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "LibListStore.h"
+
+/*
+ * nodes[0 .. size-1] are in use or on the free list, which is linked
+ * through next like the lists themselves; the array doubles when full.
+ */
+typedef struct ListStoreS {
+  StoreNode* nodes;
+  uint32_t size;
+  uint32_t capacity;
+  ListIndex freeNodes;
+} ListStoreS;
+
+static const uint32_t MIN_STORE_SIZE = 16;
+
+// file format: this magic, size and freeNodes as uint32_t, the nodes
+static const char storeMagic[8] = {'L', 'S', 'T', 'O', 'R', 'E', '0', '1'};
+
+ListStore newListStore(uint32_t capacity) {
+  ListStore st = malloc(sizeof(ListStoreS));
+  assert(st != NULL);
+  st->capacity = capacity > MIN_STORE_SIZE ? capacity : MIN_STORE_SIZE;
+  st->nodes = malloc(st->capacity * sizeof(StoreNode));
+  assert(st->nodes != NULL);
+  st->size = 0;
+  st->freeNodes = NIL_INDEX;
+  return st;
+}
+
+static ListIndex newNode(ListStore st) {
+  ListIndex node = st->freeNodes;
+  if (node != NIL_INDEX) {
+    st->freeNodes = st->nodes[node].next;
+    return node;
+  }
+  if (st->size == st->capacity) {
+    // the last index is NIL_INDEX
+    assert(st->capacity < NIL_INDEX / 2);
+    st->capacity *= 2;
+    st->nodes = realloc(st->nodes, st->capacity * sizeof(StoreNode));
+    assert(st->nodes != NULL);
+  }
+  return st->size++;
+}
+
+ListIndex addItemStore(int n, ListIndex li, ListStore st) {
+  ListIndex node = newNode(st);
+  st->nodes[node].item = n;
+  st->nodes[node].next = li;
+  return node;
+}
+
+int itemStore(ListIndex node, ListStore st) {
+  if (node == NIL_INDEX) {
+    listEmptyError();
+  }
+  return st->nodes[node].item;
+}
+
+ListIndex nextStore(ListIndex node, ListStore st) {
+  if (node == NIL_INDEX) {
+    listEmptyError();
+  }
+  return st->nodes[node].next;
+}
+
+ListIndex removeFirstStore(ListIndex li, ListStore st) {
+  if (li == NIL_INDEX) {
+    listEmptyError();
+  }
+  ListIndex rest = st->nodes[li].next;
+  st->nodes[li].next = st->freeNodes;
+  st->freeNodes = li;
+  return rest;
+}
+
+/*
+ * @brief Gives the nodes of li back to the store, for later lists
+ */
+void freeListInStore(ListIndex li, ListStore st) {
+  if (li == NIL_INDEX) {
+    return;
+  }
+  ListIndex last = li;
+  while (st->nodes[last].next != NIL_INDEX) {
+    last = st->nodes[last].next;
+  }
+  st->nodes[last].next = st->freeNodes;
+  st->freeNodes = li;
+}
+
+int lengthInStore(ListIndex li, ListStore st) {
+  int length = 0;
+  for (; li != NIL_INDEX; li = st->nodes[li].next) {
+    length++;
+  }
+  return length;
+}
+
+void printListInStore(ListIndex li, ListStore st) {
+  for (; li != NIL_INDEX; li = st->nodes[li].next) {
+    printf("%d ", st->nodes[li].item);
+  }
+}
+
+/*
+ * @brief Copies li into the store, in the same order and in consecutive
+ * nodes if the store has no free ones; li itself is not changed
+ */
+ListIndex listToStore(List li, ListStore st) {
+  ListIndex first = NIL_INDEX;
+  ListIndex last = NIL_INDEX;
+  for (; li != NULL; li = li->next) {
+    ListIndex node = addItemStore(li->item, NIL_INDEX, st);
+    if (last == NIL_INDEX) {
+      first = node;
+    } else {
+      st->nodes[last].next = node;
+    }
+    last = node;
+  }
+  return first;
+}
+
+List storeToList(ListIndex li, ListStore st) {
+  ListHandle h = newListHandle();
+  for (; li != NIL_INDEX; li = st->nodes[li].next) {
+    appendItem(st->nodes[li].item, h);
+  }
+  return detachList(h);
+}
+
+uint32_t sizeListStore(ListStore st) {
+  return st->size;
+}
+
+/*
+ * @brief The node array, valid until the next node is added
+ */
+const StoreNode* nodesListStore(ListStore st) {
+  return st->nodes;
+}
+
+/*
+ * @brief Writes the store; the heads of its lists stay valid for the
+ * store readListStore makes from it
+ * @return 1 on success, 0 on a write error
+ */
+int writeListStore(ListStore st, FILE* f) {
+  uint32_t header[2] = {st->size, st->freeNodes};
+  return fwrite(storeMagic, 1, sizeof(storeMagic), f) == sizeof(storeMagic) && fwrite(header, sizeof(uint32_t), 2, f) == 2 &&
+         fwrite(st->nodes, sizeof(StoreNode), st->size, f) == st->size;
+}
+
+/*
+ * @brief Checks that the free list and every next link of st point to a
+ * node below size or are NIL_INDEX
+ */
+static int validLinks(ListStore st) {
+  if (st->freeNodes != NIL_INDEX && st->freeNodes >= st->size) {
+    return 0;
+  }
+  for (uint32_t i = 0; i < st->size; i++) {
+    if (st->nodes[i].next != NIL_INDEX && st->nodes[i].next >= st->size) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*
+ * @brief Reads a store written by writeListStore on the same machine
+ * @return The store, or NULL if the file is not one, is cut short or has
+ * a link outside it
+ */
+ListStore readListStore(FILE* f) {
+  char magic[sizeof(storeMagic)];
+  uint32_t header[2];
+  if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) || memcmp(magic, storeMagic, sizeof(magic)) != 0 ||
+      fread(header, sizeof(uint32_t), 2, f) != 2 || header[0] == NIL_INDEX) {
+    return NULL;
+  }
+  ListStore st = newListStore(header[0]);
+  if (fread(st->nodes, sizeof(StoreNode), header[0], f) != header[0]) {
+    freeListStore(st);
+    return NULL;
+  }
+  st->size = header[0];
+  st->freeNodes = header[1];
+  if (!validLinks(st)) {
+    freeListStore(st);
+    return NULL;
+  }
+  return st;
+}
+
+void freeListStore(ListStore st) {
+  free(st->nodes);
+  free(st);
+}
@@ -0,0 +1,50 @@
+#ifndef LIBLISTSTORE_H
+#define LIBLISTSTORE_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibList.h"
+
+/*
+ * Many lists of ints in one growable array of 8-byte nodes, linked by
+ * uint32_t indices instead of pointers: half the size of a ListNode,
+ * and the nodes of all lists stay together in memory. A list is the
+ * index of its first node, NIL_INDEX for the empty list, so a graph is
+ * an array of ListIndex (one per vertex) and one ListStore. Indices stay
+ * valid when the array grows, and the array can be written to a file
+ * and read back as it is.
+ */
+typedef uint32_t ListIndex;
+
+#define NIL_INDEX UINT32_MAX
+
+typedef struct StoreNode {
+  int item;
+  ListIndex next;
+} StoreNode;
+
+typedef struct ListStoreS* ListStore;
+
+ListStore newListStore(uint32_t capacity);
+
+ListIndex addItemStore(int n, ListIndex li, ListStore st);
+int itemStore(ListIndex node, ListStore st);
+ListIndex nextStore(ListIndex node, ListStore st);
+ListIndex removeFirstStore(ListIndex li, ListStore st);
+void freeListInStore(ListIndex li, ListStore st);
+int lengthInStore(ListIndex li, ListStore st);
+void printListInStore(ListIndex li, ListStore st);
+
+ListIndex listToStore(List li, ListStore st);
+List storeToList(ListIndex li, ListStore st);
+
+uint32_t sizeListStore(ListStore st);
+const StoreNode* nodesListStore(ListStore st);
+int writeListStore(ListStore st, FILE* f);
+ListStore readListStore(FILE* f);
+void freeListStore(ListStore st);
+
+#endif
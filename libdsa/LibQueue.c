@@ -0,0 +1,236 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#define _POSIX_C_SOURCE 200809L /* pread, pwrite, posix_fadvise, mkstemp */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "LibQueue.h"
+#include "LibQueueTemplate.h"
+
+/* the int queue is the template instantiated as IntRing, plus an optional spill file */
+DEFINE_QUEUE(IntRing, int)
+
+const int INITIAL_QUEUE_SIZE = 8;
+
+/*
+ * A spilling queue keeps its oldest items in the ring (the head), its
+ * newest items in the tail buffer, and everything in between in a
+ * temporary file. The tail is written out in one large sequential write
+ * when it is full; when the ring runs empty it is refilled from the file
+ * with one large read, and the kernel is asked to read ahead the chunk
+ * after that. Items on disk are at item offsets readPos .. writePos-1.
+ */
+typedef struct Spill {
+  int fd;
+  int* tail;
+  int tailCount;
+  int segmentItems;
+  off_t readPos;
+  off_t writePos;
+} Spill;
+
+typedef struct QueueS {
+  IntRing ring;
+  Spill* spill; /* NULL for an ordinary queue */
+} QueueS;
+
+Queue newQueueWithCapacity(int capacity) {
+  Queue q = malloc(sizeof(QueueS));
+  assert(q != NULL);
+  initIntRing(&q->ring, capacity);
+  q->spill = NULL;
+  return q;
+}
+
+Queue newQueue(void) {
+  return newQueueWithCapacity(INITIAL_QUEUE_SIZE);
+}
+
+static void spillError(const char* what) {
+  perror(what);
+  abort();
+}
+
+Queue newSpillingQueue(long memoryItems) {
+  if (memoryItems < 4096) {
+    memoryItems = 4096;
+  }
+  Spill* s = malloc(sizeof(Spill));
+  assert(s != NULL);
+  s->segmentItems = memoryItems / 4 < (1 << 20) ? memoryItems / 4 : (1 << 20); /* writes of up to 4 MiB */
+  s->tail = malloc(s->segmentItems * sizeof(int));
+  assert(s->tail != NULL);
+  s->tailCount = 0;
+  s->readPos = s->writePos = 0;
+
+  const char* dir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/queue-XXXXXX", dir);
+  s->fd = mkstemp(path);
+  if (s->fd < 0) {
+    spillError(path);
+  }
+  unlink(path); /* the file disappears with the last descriptor */
+
+  /* the rest of the budget is the ring, rounded down to a power of two */
+  long ringItems = MIN_QUEUE_SIZE;
+  while (2 * ringItems <= memoryItems - s->segmentItems && 2 * ringItems <= (1L << 30)) {
+    ringItems *= 2;
+  }
+  Queue q = newQueueWithCapacity(ringItems);
+  q->spill = s;
+  return q;
+}
+
+static long spilledItems(Spill* s) {
+  return (long)(s->writePos - s->readPos) + s->tailCount;
+}
+
+static void writeAll(int fd, const void* buffer, size_t bytes, off_t offset) {
+  while (bytes > 0) {
+    ssize_t done = pwrite(fd, buffer, bytes, offset);
+    if (done < 0) {
+      spillError("queue spill write");
+    }
+    buffer = (const char*)buffer + done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+static void readAll(int fd, void* buffer, size_t bytes, off_t offset) {
+  while (bytes > 0) {
+    ssize_t done = pread(fd, buffer, bytes, offset);
+    if (done <= 0) {
+      spillError("queue spill read");
+    }
+    buffer = (char*)buffer + done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+static void spillEnqueue(int item, Queue q) {
+  Spill* s = q->spill;
+  if (spilledItems(s) == 0 && q->ring.count < q->ring.size) {
+    enqueueIntRing(item, &q->ring);
+    return;
+  }
+  s->tail[s->tailCount] = item;
+  s->tailCount++;
+  if (s->tailCount == s->segmentItems) {
+    writeAll(s->fd, s->tail, s->tailCount * sizeof(int), s->writePos * sizeof(int));
+    s->writePos += s->tailCount;
+    s->tailCount = 0;
+  }
+}
+
+/* the ring is empty: move the next items in FIFO order into it */
+static void refill(Queue q) {
+  Spill* s = q->spill;
+  clearIntRing(&q->ring);
+  if (s->readPos < s->writePos) {
+    off_t n = s->writePos - s->readPos < q->ring.size ? s->writePos - s->readPos : q->ring.size;
+    readAll(s->fd, q->ring.array, n * sizeof(int), s->readPos * sizeof(int));
+    q->ring.count = n;
+    s->readPos += n;
+    if (s->readPos == s->writePos) {
+      /* the file is empty: give the disk space back */
+      s->readPos = s->writePos = 0;
+      if (ftruncate(s->fd, 0) != 0) {
+        spillError("queue spill truncate");
+      }
+    } else {
+      off_t next = s->writePos - s->readPos < q->ring.size ? s->writePos - s->readPos : q->ring.size;
+      posix_fadvise(s->fd, s->readPos * sizeof(int), next * sizeof(int), POSIX_FADV_WILLNEED);
+    }
+  } else if (s->tailCount > 0) {
+    enqueueManyIntRing(s->tail, s->tailCount, &q->ring);
+    s->tailCount = 0;
+  }
+}
+
+int isEmptyQueue(Queue q) {
+  return isEmptyIntRing(&q->ring) && (q->spill == NULL || spilledItems(q->spill) == 0);
+}
+
+long lengthQueue(Queue q) {
+  return (long)lengthIntRing(&q->ring) + (q->spill == NULL ? 0 : spilledItems(q->spill));
+}
+
+void enqueue(int item, Queue q) {
+  if (q->spill == NULL) {
+    enqueueIntRing(item, &q->ring);
+  } else {
+    spillEnqueue(item, q);
+  }
+}
+
+int dequeue(Queue q) {
+  if (q->spill != NULL && isEmptyIntRing(&q->ring)) {
+    refill(q);
+  }
+  return dequeueIntRing(&q->ring);
+}
+
+void enqueueMany(const int* items, int n, Queue q) {
+  if (q->spill == NULL) {
+    enqueueManyIntRing(items, n, &q->ring);
+    return;
+  }
+  for (int i = 0; i < n; i++) {
+    spillEnqueue(items[i], q);
+  }
+}
+
+/* dequeues up to n items into items and returns how many there were */
+int dequeueMany(int* items, int n, Queue q) {
+  if (q->spill == NULL) {
+    return dequeueManyIntRing(items, n, &q->ring);
+  }
+  int m = 0;
+  while (m < n && !isEmptyQueue(q)) {
+    if (isEmptyIntRing(&q->ring)) {
+      refill(q);
+    }
+    m += dequeueManyIntRing(items + m, n - m, &q->ring);
+  }
+  return m;
+}
+
+/* the queue will not shrink below capacity until shrinkQueueToFit */
+void reserveQueue(int capacity, Queue q) {
+  reserveIntRing(capacity, &q->ring);
+}
+
+void shrinkQueueToFit(Queue q) {
+  if (q->spill == NULL) {
+    shrinkToFitIntRing(&q->ring);
+  }
+}
+
+/* removes all items but keeps the storage for reuse */
+void clearQueue(Queue q) {
+  clearIntRing(&q->ring);
+  if (q->spill != NULL) {
+    q->spill->tailCount = 0;
+    q->spill->readPos = q->spill->writePos = 0;
+    if (ftruncate(q->spill->fd, 0) != 0) {
+      spillError("queue spill truncate");
+    }
+  }
+}
+
+void freeQueue(Queue q) {
+  if (q->spill != NULL) {
+    close(q->spill->fd);
+    free(q->spill->tail);
+    free(q->spill);
+  }
+  destroyIntRing(&q->ring);
+  free(q);
+}
@@ -0,0 +1,33 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#ifndef LIBQUEUE_H
+#define LIBQUEUE_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct QueueS* Queue;
+
+Queue newQueue(void);
+Queue newQueueWithCapacity(int capacity);
+
+/* keeps about memoryItems items in memory and the rest in a temporary file
+ * (in $TMPDIR, default /tmp); all functions below work on it as usual */
+Queue newSpillingQueue(long memoryItems);
+
+void enqueue(int item, Queue q);
+int dequeue(Queue q);
+
+void enqueueMany(const int* items, int n, Queue q);
+int dequeueMany(int* items, int n, Queue q);
+
+int isEmptyQueue(Queue q);
+long lengthQueue(Queue q);
+
+void reserveQueue(int capacity, Queue q);
+void shrinkQueueToFit(Queue q);
+void clearQueue(Queue q);
+void freeQueue(Queue q);
+
+#endif
@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibQueueMPMC.h"
+
+#define CACHE_LINE 64
+
+/*
+ * Slot i of the ring is free for the enqueuer that claims position p
+ * (p & mask == i) when sequence == p, and holds the item for the dequeuer
+ * of position p when sequence == p + 1. After the dequeue the slot is
+ * handed to position p + size.
+ */
+typedef struct Cell {
+  atomic_size_t sequence;
+  int item;
+} Cell;
+
+typedef struct QueueMPMCS {
+  _Alignas(CACHE_LINE) Cell* buffer;
+  size_t mask;
+  _Alignas(CACHE_LINE) atomic_size_t enqueuePos;
+  _Alignas(CACHE_LINE) atomic_size_t dequeuePos;
+} QueueMPMCS;
+
+QueueMPMC newQueueMPMC(int capacity) {
+  // a power of two, 2 for a capacity of 0 or less and at most 2^31 (above INT_MAX)
+  size_t size = 2;
+  while (capacity > 0 && size < (size_t)capacity) {
+    size *= 2;
+  }
+  QueueMPMC q = aligned_alloc(CACHE_LINE, sizeof(QueueMPMCS));
+  assert(q != NULL);
+  q->buffer = malloc(size * sizeof(Cell));
+  assert(q->buffer != NULL);
+  for (size_t i = 0; i < size; i++) {
+    atomic_init(&q->buffer[i].sequence, i);
+  }
+  q->mask = size - 1;
+  atomic_init(&q->enqueuePos, 0);
+  atomic_init(&q->dequeuePos, 0);
+  return q;
+}
+
+int tryEnqueueMPMC(int item, QueueMPMC q) {
+  size_t pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &q->buffer[pos & q->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0) {
+      /* the slot is free: try to claim position pos */
+      if (atomic_compare_exchange_weak_explicit(&q->enqueuePos, &pos, pos + 1, memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return 0; /* the slot still holds the item from one lap ago: full */
+    } else {
+      pos = atomic_load_explicit(&q->enqueuePos, memory_order_relaxed);
+    }
+  }
+  cell->item = item;
+  /* release: publish the item to the dequeuer of position pos */
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+  return 1;
+}
+
+int tryDequeueMPMC(int* item, QueueMPMC q) {
+  size_t pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &q->buffer[pos & q->mask];
+    size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(&q->dequeuePos, &pos, pos + 1, memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return 0; /* nothing has been enqueued at position pos yet: empty */
+    } else {
+      pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+    }
+  }
+  *item = cell->item;
+  /* release: hand the slot to the enqueuer one lap ahead */
+  atomic_store_explicit(&cell->sequence, pos + q->mask + 1, memory_order_release);
+  return 1;
+}
+
+void enqueueMPMC(int item, QueueMPMC q) {
+  while (!tryEnqueueMPMC(item, q)) {
+    sched_yield();
+  }
+}
+
+int dequeueMPMC(QueueMPMC q) {
+  int item;
+  while (!tryDequeueMPMC(&item, q)) {
+    sched_yield();
+  }
+  return item;
+}
+
+/* only a snapshot while other threads are active */
+int isEmptyQueueMPMC(QueueMPMC q) {
+  size_t pos = atomic_load_explicit(&q->dequeuePos, memory_order_relaxed);
+  size_t seq = atomic_load_explicit(&q->buffer[pos & q->mask].sequence, memory_order_acquire);
+  return (intptr_t)seq - (intptr_t)(pos + 1) < 0;
+}
+
+void freeQueueMPMC(QueueMPMC q) {
+  free(q->buffer);
+  free(q);
+}
@@ -0,0 +1,25 @@
+#ifndef LIBQUEUEMPMC_H
+#define LIBQUEUEMPMC_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Bounded lock-free queue for any number of producer and consumer threads
+ * (Dmitry Vyukov's design with one sequence number per slot).
+ */
+typedef struct QueueMPMCS* QueueMPMC;
+
+QueueMPMC newQueueMPMC(int capacity);
+
+void enqueueMPMC(int item, QueueMPMC q);
+int dequeueMPMC(QueueMPMC q);
+
+int tryEnqueueMPMC(int item, QueueMPMC q);
+int tryDequeueMPMC(int* item, QueueMPMC q);
+
+int isEmptyQueueMPMC(QueueMPMC q);
+void freeQueueMPMC(QueueMPMC q);
+
+#endif
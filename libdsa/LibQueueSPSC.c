@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibQueueSPSC.h"
+
+#define CACHE_LINE 64
+
+/*
+ * head and tail count all dequeued and enqueued items; slot i lives at
+ * array[i & mask]. Each index sits on its own cache line together with the
+ * owner's cached copy of the other index, so in the common case neither
+ * thread touches the other's line.
+ */
+typedef struct QueueSPSCS {
+  _Alignas(CACHE_LINE) atomic_size_t tail; /* written by the producer */
+  size_t headCache;                        /* producer's last view of head */
+  _Alignas(CACHE_LINE) atomic_size_t head; /* written by the consumer */
+  size_t tailCache;                        /* consumer's last view of tail */
+  _Alignas(CACHE_LINE) int* array;
+  size_t mask;
+} QueueSPSCS;
+
+QueueSPSC newQueueSPSC(int capacity) {
+  // a power of two, 2 for a capacity of 0 or less and at most 2^31 (above INT_MAX)
+  size_t size = 2;
+  while (capacity > 0 && size < (size_t)capacity) {
+    size *= 2;
+  }
+  QueueSPSC q = aligned_alloc(CACHE_LINE, sizeof(QueueSPSCS));
+  assert(q != NULL);
+  q->array = malloc(size * sizeof(int));
+  assert(q->array != NULL);
+  q->mask = size - 1;
+  atomic_init(&q->tail, 0);
+  atomic_init(&q->head, 0);
+  q->headCache = 0;
+  q->tailCache = 0;
+  return q;
+}
+
+int tryEnqueueSPSC(int item, QueueSPSC q) {
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (tail - q->headCache > q->mask) {
+    /* acquire: the consumer has finished reading the slot we will reuse */
+    q->headCache = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail - q->headCache > q->mask) {
+      return 0;
+    }
+  }
+  q->array[tail & q->mask] = item;
+  /* release: publish the item before the new tail */
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return 1;
+}
+
+int tryDequeueSPSC(int* item, QueueSPSC q) {
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (head == q->tailCache) {
+    /* acquire: pairs with the producer's release, so the item is visible */
+    q->tailCache = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head == q->tailCache) {
+      return 0;
+    }
+  }
+  *item = q->array[head & q->mask];
+  /* release: the slot may be overwritten only after we have read it */
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return 1;
+}
+
+void enqueueSPSC(int item, QueueSPSC q) {
+  while (!tryEnqueueSPSC(item, q)) {
+    sched_yield();
+  }
+}
+
+int dequeueSPSC(QueueSPSC q) {
+  int item;
+  while (!tryDequeueSPSC(&item, q)) {
+    sched_yield();
+  }
+  return item;
+}
+
+/* exact when called by the consumer; a snapshot from any other thread */
+int isEmptyQueueSPSC(QueueSPSC q) {
+  return atomic_load_explicit(&q->head, memory_order_relaxed) ==
+         atomic_load_explicit(&q->tail, memory_order_acquire);
+}
+
+void freeQueueSPSC(QueueSPSC q) {
+  free(q->array);
+  free(q);
+}
@@ -0,0 +1,26 @@
+#ifndef LIBQUEUESPSC_H
+#define LIBQUEUESPSC_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Only the producer may call enqueueSPSC/tryEnqueueSPSC and only
+ * the consumer may call dequeueSPSC/tryDequeueSPSC.
+ */
+typedef struct QueueSPSCS* QueueSPSC;
+
+QueueSPSC newQueueSPSC(int capacity);
+
+void enqueueSPSC(int item, QueueSPSC q);
+int dequeueSPSC(QueueSPSC q);
+
+int tryEnqueueSPSC(int item, QueueSPSC q);
+int tryDequeueSPSC(int* item, QueueSPSC q);
+
+int isEmptyQueueSPSC(QueueSPSC q);
+void freeQueueSPSC(QueueSPSC q);
+
+#endif
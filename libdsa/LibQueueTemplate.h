@@ -0,0 +1,214 @@
+#ifndef LIBQUEUETEMPLATE_H
+#define LIBQUEUETEMPLATE_H
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * DEFINE_QUEUE(Name, T) defines a FIFO queue type Name that stores items of
+ * type T by value in a power-of-two ring, together with these functions:
+ *
+ *   Name* newName(int capacity);   capacity is a hint, 0 for the default
+ *   void enqueueName(T item, Name* q);
+ *   T dequeueName(Name* q);        aborts if the queue is empty
+ *   void enqueueManyName(const T* items, int n, Name* q);
+ *   int dequeueManyName(T* items, int n, Name* q);   returns how many
+ *   int isEmptyName(Name* q);
+ *   int lengthName(Name* q);
+ *   void reserveName(int capacity, Name* q);   never shrinks below capacity
+ *   void shrinkToFitName(Name* q);   smallest size that holds the items
+ *   void clearName(Name* q);       empties the queue, keeps the array
+ *   void freeName(Name* q);
+ *   void initName(Name* q, int capacity), destroyName(Name* q);
+ *                                  the same for a Name inside another struct
+ *
+ * The array doubles when it is full and halves when less than a quarter
+ * of it is used, but never below the capacity given to newName or
+ * reserveName. The gap between the two thresholds keeps a queue that
+ * hovers around one size from resizing on every operation.
+ *
+ * All functions are static inline, so the compiler can inline them at
+ * every call site. Use it once per item type, at file scope.
+ */
+#define MIN_QUEUE_SIZE 8
+
+/*
+ * @brief The power of two an array for capacity items gets: at least
+ * MIN_QUEUE_SIZE (also for a negative capacity), at most 2^31
+ */
+static inline unsigned int queueSizeFor(int capacity) {
+  unsigned int size = MIN_QUEUE_SIZE;
+  while (capacity > 0 && size < (unsigned int)capacity && size <= UINT_MAX / 2) {
+    size *= 2;
+  }
+  return size;
+}
+
+#define DEFINE_QUEUE(Name, T)                                                                            \
+  typedef struct Name {                                                                                  \
+    T* array;                                                                                            \
+    unsigned int front;                                                                                  \
+    unsigned int count;                                                                                  \
+    unsigned int size;                                                                                   \
+    unsigned int minSize;                                                                                \
+  } Name;                                                                                                \
+                                                                                                         \
+  /* for a queue embedded in another struct; pair with destroyName */                                    \
+  static inline void init##Name(Name* q, int capacity) {                                                 \
+    unsigned int size = queueSizeFor(capacity);                                                          \
+    q->array = malloc(size * sizeof(T));                                                                 \
+    assert(q->array != NULL);                                                                            \
+    q->front = 0;                                                                                        \
+    q->count = 0;                                                                                        \
+    q->size = size;                                                                                      \
+    q->minSize = size;                                                                                   \
+  }                                                                                                      \
+                                                                                                         \
+  static inline Name* new##Name(int capacity) {                                                          \
+    Name* q = malloc(sizeof(Name));                                                                      \
+    assert(q != NULL);                                                                                   \
+    init##Name(q, capacity);                                                                             \
+    return q;                                                                                            \
+  }                                                                                                      \
+                                                                                                         \
+  static inline int isEmpty##Name(Name* q) {                                                             \
+    return (q->count == 0);                                                                              \
+  }                                                                                                      \
+                                                                                                         \
+  static inline int length##Name(Name* q) {                                                              \
+    return q->count;                                                                                     \
+  }                                                                                                      \
+                                                                                                         \
+  /* eliminate split configuration by moving the shorter of the two parts */                             \
+  static inline void doubleSize##Name(Name* q) {                                                         \
+    unsigned int oldSize = q->size;                                                                      \
+    q->size = 2 * oldSize;                                                                               \
+    q->array = realloc(q->array, q->size * sizeof(T));                                                   \
+    assert(q->array != NULL);                                                                            \
+    unsigned int wrapped = q->front + q->count > oldSize ? q->front + q->count - oldSize : 0;            \
+    if (wrapped <= oldSize - q->front) {                                                                 \
+      memcpy(q->array + oldSize, q->array, wrapped * sizeof(T));                                         \
+    } else {                                                                                             \
+      memcpy(q->array + q->front + oldSize, q->array + q->front, (oldSize - q->front) * sizeof(T));      \
+      q->front += oldSize;                                                                               \
+    }                                                                                                    \
+  }                                                                                                      \
+                                                                                                         \
+  /* moves the items to the front of an array of newSize >= count; shrinking */                          \
+  /* in place with realloc lets malloc hand the tail of a large array back */                            \
+  static inline void resize##Name(unsigned int newSize, Name* q) {                                       \
+    unsigned int first = q->size - q->front < q->count ? q->size - q->front : q->count;                  \
+    unsigned int wrapped = q->count - first;                                                             \
+    if (q->count + first <= q->size) {                                                                   \
+      /* in place: the wrapped part goes behind the first part, which then moves down */                 \
+      memmove(q->array + first, q->array, wrapped * sizeof(T));                                          \
+      memmove(q->array, q->array + q->front, first * sizeof(T));                                         \
+      q->array = realloc(q->array, newSize * sizeof(T));                                                 \
+      assert(q->array != NULL);                                                                          \
+    } else {                                                                                             \
+      T* array = malloc(newSize * sizeof(T));                                                            \
+      assert(array != NULL);                                                                             \
+      memcpy(array, q->array + q->front, first * sizeof(T));                                             \
+      memcpy(array + first, q->array, wrapped * sizeof(T));                                              \
+      free(q->array);                                                                                    \
+      q->array = array;                                                                                  \
+    }                                                                                                    \
+    q->front = 0;                                                                                        \
+    q->size = newSize;                                                                                   \
+  }                                                                                                      \
+                                                                                                         \
+  /* halve (repeatedly) while less than a quarter is used */                                             \
+  static inline void shrink##Name(Name* q) {                                                             \
+    unsigned int newSize = q->size;                                                                      \
+    while (q->count < newSize / 4 && newSize / 2 >= q->minSize) {                                        \
+      newSize /= 2;                                                                                      \
+    }                                                                                                    \
+    if (newSize != q->size) {                                                                            \
+      resize##Name(newSize, q);                                                                          \
+    }                                                                                                    \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void enqueue##Name(T item, Name* q) {                                                    \
+    if (q->count == q->size) {                                                                           \
+      doubleSize##Name(q);                                                                               \
+    }                                                                                                    \
+    q->array[(q->front + q->count) & (q->size - 1)] = item;                                              \
+    q->count++;                                                                                          \
+  }                                                                                                      \
+                                                                                                         \
+  static inline T dequeue##Name(Name* q) {                                                               \
+    if (isEmpty##Name(q)) {                                                                              \
+      printf("queue empty\n");                                                                           \
+      abort();                                                                                           \
+    }                                                                                                    \
+    T item = q->array[q->front];                                                                         \
+    q->front = (q->front + 1) & (q->size - 1);                                                           \
+    q->count--;                                                                                          \
+    if (q->count < q->size / 4 && q->size / 2 >= q->minSize) {                                           \
+      shrink##Name(q);                                                                                   \
+    }                                                                                                    \
+    return item;                                                                                         \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void enqueueMany##Name(const T* items, int n, Name* q) {                                 \
+    assert(n >= 0);                                                                                      \
+    while (q->size - q->count < (unsigned int)n) {                                                       \
+      doubleSize##Name(q);                                                                               \
+    }                                                                                                    \
+    unsigned int back = (q->front + q->count) & (q->size - 1);                                           \
+    unsigned int first = q->size - back < (unsigned int)n ? q->size - back : (unsigned int)n;            \
+    memcpy(q->array + back, items, first * sizeof(T));                                                   \
+    memcpy(q->array, items + first, (n - first) * sizeof(T));                                            \
+    q->count += n;                                                                                       \
+  }                                                                                                      \
+                                                                                                         \
+  static inline int dequeueMany##Name(T* items, int n, Name* q) {                                        \
+    assert(n >= 0);                                                                                      \
+    unsigned int m = q->count < (unsigned int)n ? q->count : (unsigned int)n;                            \
+    unsigned int first = q->size - q->front < m ? q->size - q->front : m;                                \
+    memcpy(items, q->array + q->front, first * sizeof(T));                                               \
+    memcpy(items + first, q->array, (m - first) * sizeof(T));                                            \
+    q->front = (q->front + m) & (q->size - 1);                                                           \
+    q->count -= m;                                                                                       \
+    shrink##Name(q);                                                                                     \
+    return m;                                                                                            \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void reserve##Name(int capacity, Name* q) {                                              \
+    unsigned int size = queueSizeFor(capacity);                                                          \
+    q->minSize = size;                                                                                   \
+    if (q->size < size) {                                                                                \
+      resize##Name(size, q);                                                                             \
+    }                                                                                                    \
+  }                                                                                                      \
+                                                                                                         \
+  /* also drops the capacity given to new or reserve */                                                  \
+  static inline void shrinkToFit##Name(Name* q) {                                                        \
+    unsigned int size = MIN_QUEUE_SIZE;                                                                  \
+    while (size < q->count) {                                                                            \
+      size *= 2;                                                                                         \
+    }                                                                                                    \
+    q->minSize = MIN_QUEUE_SIZE;                                                                         \
+    if (size != q->size) {                                                                               \
+      resize##Name(size, q);                                                                             \
+    }                                                                                                    \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void clear##Name(Name* q) {                                                              \
+    q->front = 0;                                                                                        \
+    q->count = 0;                                                                                        \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void destroy##Name(Name* q) {                                                            \
+    free(q->array);                                                                                      \
+  }                                                                                                      \
+                                                                                                         \
+  static inline void free##Name(Name* q) {                                                               \
+    destroy##Name(q);                                                                                    \
+    free(q);                                                                                             \
+  }
+
+#endif
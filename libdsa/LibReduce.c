@@ -0,0 +1,368 @@
+#include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "LibReduce.h"
+
+#define GATHER_BLOCK 4096 /* items gathered from a list or tree at a time */
+
+#if defined(__SSE2__) && !defined(__AVX2__)
+// SSE2 has no 32-bit min/max and no sign extension to 64 bits
+
+static __m128i max4(__m128i a, __m128i b) {
+  __m128i greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+static __m128i min4(__m128i a, __m128i b) {
+  __m128i greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+}
+
+static __m128i add4to64(__m128i acc, __m128i v) {
+  __m128i sign = _mm_srai_epi32(v, 31);
+  acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+  return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+}
+#endif
+
+long long sumArray(const int* arr, size_t n) {
+  size_t i = 0;
+  long long sum = 0;
+#if defined(__AVX2__)
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(arr + i))));
+    acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(arr + i + 4))));
+    acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(arr + i + 8))));
+    acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(arr + i + 12))));
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i));
+    acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+  }
+  long long lanes[4];
+  _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(acc0, acc1));
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 4 <= n; i += 4) {
+    acc = add4to64(acc, _mm_loadu_si128((const __m128i*)(arr + i)));
+  }
+  long long lanes[2];
+  _mm_storeu_si128((__m128i*)lanes, acc);
+  sum = lanes[0] + lanes[1];
+#endif
+  for (; i < n; i++) {
+    sum += arr[i];
+  }
+  return sum;
+}
+
+/*
+ * @brief Sum (if sum is not NULL), minimum and maximum in one pass
+ */
+static void sumMinMax(const int* arr, size_t n, long long* sum, int* min, int* max) {
+  size_t i = 0;
+  long long total = 0;
+  int lo = INT_MAX;
+  int hi = INT_MIN;
+#if defined(__AVX2__)
+  if (n >= 8) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i lo8 = _mm256_loadu_si256((const __m256i*)arr);
+    __m256i hi8 = lo8;
+    // two vectors per round, so more loads are in flight
+    for (; i + 16 <= n; i += 16) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i));
+      __m256i w = _mm256_loadu_si256((const __m256i*)(arr + i + 8));
+      if (sum != NULL) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(w)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(w, 1)));
+      }
+      lo8 = _mm256_min_epi32(lo8, _mm256_min_epi32(v, w));
+      hi8 = _mm256_max_epi32(hi8, _mm256_max_epi32(v, w));
+    }
+    for (; i + 8 <= n; i += 8) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i));
+      if (sum != NULL) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+      }
+      lo8 = _mm256_min_epi32(lo8, v);
+      hi8 = _mm256_max_epi32(hi8, v);
+    }
+    long long sums[4];
+    int los[8];
+    int his[8];
+    _mm256_storeu_si256((__m256i*)sums, _mm256_add_epi64(acc0, acc1));
+    _mm256_storeu_si256((__m256i*)los, lo8);
+    _mm256_storeu_si256((__m256i*)his, hi8);
+    total = sums[0] + sums[1] + sums[2] + sums[3];
+    for (int k = 0; k < 8; k++) {
+      lo = los[k] < lo ? los[k] : lo;
+      hi = his[k] > hi ? his[k] : hi;
+    }
+  }
+#elif defined(__SSE2__)
+  if (n >= 4) {
+    __m128i acc = _mm_setzero_si128();
+    __m128i lo4 = _mm_loadu_si128((const __m128i*)arr);
+    __m128i hi4 = lo4;
+    for (; i + 4 <= n; i += 4) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(arr + i));
+      if (sum != NULL) {
+        acc = add4to64(acc, v);
+      }
+      lo4 = min4(lo4, v);
+      hi4 = max4(hi4, v);
+    }
+    long long sums[2];
+    int los[4];
+    int his[4];
+    _mm_storeu_si128((__m128i*)sums, acc);
+    _mm_storeu_si128((__m128i*)los, lo4);
+    _mm_storeu_si128((__m128i*)his, hi4);
+    total = sums[0] + sums[1];
+    for (int k = 0; k < 4; k++) {
+      lo = los[k] < lo ? los[k] : lo;
+      hi = his[k] > hi ? his[k] : hi;
+    }
+  }
+#endif
+  for (; i < n; i++) {
+    total += arr[i];
+    lo = arr[i] < lo ? arr[i] : lo;
+    hi = arr[i] > hi ? arr[i] : hi;
+  }
+  if (sum != NULL) {
+    *sum = total;
+  }
+  *min = lo;
+  *max = hi;
+}
+
+int minOfArray(const int* arr, size_t n) {
+  int min;
+  int max;
+  sumMinMax(arr, n, NULL, &min, &max);
+  return min;
+}
+
+int maxOfArray(const int* arr, size_t n) {
+  int min;
+  int max;
+  sumMinMax(arr, n, NULL, &min, &max);
+  return max;
+}
+
+/*
+ * @brief Position of the first n in arr, or size if there is none
+ */
+static size_t findFirst(const int* arr, size_t size, int n) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  __m256i key = _mm256_set1_epi32(n);
+  for (; i + 8 <= size; i += 8) {
+    __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr + i)), key);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#elif defined(__SSE2__)
+  __m128i key = _mm_set1_epi32(n);
+  for (; i + 4 <= size; i += 4) {
+    __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i)), key);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    if (arr[i] == n) {
+      return i;
+    }
+  }
+  return size;
+}
+
+/*
+ * @brief Reduces arr a block at a time, remembering the first block
+ * with the largest maximum; only that block, still in the cache, is
+ * searched again for the position of the maximum. Keeping positions in
+ * every vector lane would cost more than that.
+ */
+static Reduction reduceBlocks(const int* arr, size_t n, int withSum) {
+  Reduction r = {0, INT_MAX, INT_MIN, 0, n};
+  size_t maxBlock = 0;
+  for (size_t begin = 0; begin < n; begin += GATHER_BLOCK) {
+    size_t length = n - begin < GATHER_BLOCK ? n - begin : GATHER_BLOCK;
+    long long sum;
+    int min;
+    int max;
+    sumMinMax(arr + begin, length, withSum ? &sum : NULL, &min, &max);
+    if (withSum) {
+      r.sum += sum;
+    }
+    r.min = min < r.min ? min : r.min;
+    if (max > r.max) {
+      r.max = max;
+      maxBlock = begin;
+    }
+  }
+  if (n > 0) {
+    size_t length = n - maxBlock < GATHER_BLOCK ? n - maxBlock : GATHER_BLOCK;
+    r.argmax = maxBlock + findFirst(arr + maxBlock, length, r.max);
+  }
+  return r;
+}
+
+size_t argmaxOfArray(const int* arr, size_t n) {
+  return reduceBlocks(arr, n, 0).argmax;
+}
+
+Reduction reduceArray(const int* arr, size_t n) {
+  return reduceBlocks(arr, n, 1);
+}
+
+static Reduction emptyReduction(void) {
+  Reduction r = {0, INT_MAX, INT_MIN, 0, 0};
+  return r;
+}
+
+/*
+ * @brief Adds b, the reduction of the items right after those of a, to a
+ */
+static void combine(Reduction* a, Reduction b) {
+  if (b.count == 0) {
+    return;
+  }
+  if (a->count == 0 || b.max > a->max) {
+    a->argmax = a->count + b.argmax;
+  }
+  a->sum += b.sum;
+  a->min = b.min < a->min ? b.min : a->min;
+  a->max = b.max > a->max ? b.max : a->max;
+  a->count += b.count;
+}
+
+typedef struct Chunk {
+  const int* arr;
+  size_t n;
+  Reduction result;
+  int onThread;  // 0 if reduced by the calling thread
+} Chunk;
+
+static void* reduceChunk(void* arg) {
+  Chunk* c = arg;
+  c->result = reduceArray(c->arr, c->n);
+  return NULL;
+}
+
+/*
+ * @brief reduceArray on threads consecutive chunks at once (the calling
+ * thread does the first, and any chunk whose thread cannot be created),
+ * combined in order
+ */
+Reduction reduceArrayParallel(const int* arr, size_t n, int threads) {
+  if (threads < 1) {
+    threads = 1;
+  }
+  if ((size_t)threads > n / GATHER_BLOCK) {
+    threads = n / GATHER_BLOCK > 0 ? (int)(n / GATHER_BLOCK) : 1;
+  }
+  Chunk* chunks = malloc(threads * sizeof(Chunk));
+  pthread_t* workers = malloc(threads * sizeof(pthread_t));
+  assert(chunks != NULL && workers != NULL);
+  size_t begin = 0;
+  for (int k = 0; k < threads; k++) {
+    // chunk borders on 64-byte lines
+    size_t end = k == threads - 1 ? n : (n / threads * (k + 1)) & ~(size_t)15;
+    chunks[k].arr = arr + begin;
+    chunks[k].n = end - begin;
+    begin = end;
+    // without a thread (none for the first chunk, or none could be
+    // created) the calling thread reduces the chunk itself
+    chunks[k].onThread = k > 0 && pthread_create(&workers[k], NULL, reduceChunk, &chunks[k]) == 0;
+    if (k > 0 && !chunks[k].onThread) {
+      reduceChunk(&chunks[k]);
+    }
+  }
+  reduceChunk(&chunks[0]);
+  Reduction r = chunks[0].result;
+  for (int k = 1; k < threads; k++) {
+    if (chunks[k].onThread) {
+      pthread_join(workers[k], NULL);
+    }
+    combine(&r, chunks[k].result);
+  }
+  free(chunks);
+  free(workers);
+  return r;
+}
+
+Reduction reduceList(List li) {
+  int* block = malloc(GATHER_BLOCK * sizeof(int));
+  assert(block != NULL);
+  Reduction r = emptyReduction();
+  while (li != NULL) {
+    size_t n = 0;
+    for (; li != NULL && n < GATHER_BLOCK; li = li->next) {
+      block[n++] = li->item;
+    }
+    combine(&r, reduceArray(block, n));
+  }
+  free(block);
+  return r;
+}
+
+/*
+ * @brief Gathers the items in pre-order with a stack instead of
+ * recursion, so a degenerate tree cannot overflow the call stack
+ */
+Reduction reduceTree(Tree t) {
+  int* block = malloc(GATHER_BLOCK * sizeof(int));
+  size_t capacity = 64;
+  size_t top = 0;
+  Tree* stack = malloc(capacity * sizeof(Tree));
+  assert(block != NULL && stack != NULL);
+  Reduction r = emptyReduction();
+  if (t != NULL) {
+    stack[top++] = t;
+  }
+  while (top > 0) {
+    size_t n = 0;
+    while (top > 0 && n < GATHER_BLOCK) {
+      Tree node = stack[--top];
+      block[n++] = node->item;
+      if (top + 2 > capacity) {
+        capacity *= 2;
+        stack = realloc(stack, capacity * sizeof(Tree));
+        assert(stack != NULL);
+      }
+      if (node->rightChild != NULL) {
+        stack[top++] = node->rightChild;
+      }
+      if (node->leftChild != NULL) {
+        stack[top++] = node->leftChild;
+      }
+    }
+    combine(&r, reduceArray(block, n));
+  }
+  free(block);
+  free(stack);
+  return r;
+}
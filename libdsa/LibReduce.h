@@ -0,0 +1,38 @@
+#ifndef LIBREDUCE_H
+#define LIBREDUCE_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibList.h"
+#include "LibTree.h"
+
+/*
+ * Sum, minimum, maximum and the position of the first maximum of many
+ * ints, computed with AVX2 or SSE2 when the library is built for them.
+ * Sums use 64-bit accumulators, so they do not overflow for fewer than
+ * 2^32 items. Lists and trees are first gathered into blocks of items,
+ * so the same array kernels do the arithmetic. An empty input has sum
+ * 0, min INT_MAX, max INT_MIN and argmax 0.
+ */
+typedef struct Reduction {
+  long long sum;
+  int min;
+  int max;
+  size_t argmax;  // position of the first maximum (pre-order for trees)
+  size_t count;
+} Reduction;
+
+long long sumArray(const int* arr, size_t n);
+int minOfArray(const int* arr, size_t n);
+int maxOfArray(const int* arr, size_t n);
+size_t argmaxOfArray(const int* arr, size_t n);
+
+Reduction reduceArray(const int* arr, size_t n);
+Reduction reduceArrayParallel(const int* arr, size_t n, int threads);
+Reduction reduceList(List li);
+Reduction reduceTree(Tree t);
+
+#endif
@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDequeWS.h"
+#include "LibScheduler.h"
+
+#define INITIAL_DEQUE_SIZE 64
+
+typedef struct Worker {
+  Scheduler s;
+  int id;
+  uint64_t random; /* xorshift state for picking victims */
+  long steals;
+  int onThread; /* 0 for worker 0 and a worker whose thread could not be created */
+} Worker;
+
+/*
+ * pending counts the tasks that were spawned but have not finished yet.
+ * A task spawns its children before it finishes, so pending only reaches
+ * zero when there is no work left anywhere.
+ */
+typedef struct SchedulerS {
+  int workers;
+  TaskFunction run;
+  void* context;
+  DequeWS* deques;
+  Worker* state;
+  atomic_long pending;
+} SchedulerS;
+
+Scheduler newScheduler(int workers, TaskFunction run, void* context) {
+  assert(workers >= 1);
+  Scheduler s = malloc(sizeof(SchedulerS));
+  assert(s != NULL);
+  s->workers = workers;
+  s->run = run;
+  s->context = context;
+  s->deques = malloc(workers * sizeof(DequeWS));
+  s->state = malloc(workers * sizeof(Worker));
+  assert(s->deques != NULL && s->state != NULL);
+  for (int w = 0; w < workers; w++) {
+    s->deques[w] = newDequeWS(INITIAL_DEQUE_SIZE);
+    s->state[w].s = s;
+    s->state[w].id = w;
+    s->state[w].random = 0x9E3779B97F4A7C15u * (w + 1);
+    s->state[w].steals = 0;
+    s->state[w].onThread = 0;
+  }
+  atomic_init(&s->pending, 0);
+  return s;
+}
+
+void spawnTask(int task, int worker, Scheduler s) {
+  atomic_fetch_add_explicit(&s->pending, 1, memory_order_relaxed);
+  pushDequeWS(task, s->deques[worker]);
+}
+
+int victim(Worker* w) {
+  w->random ^= w->random << 13;
+  w->random ^= w->random >> 7;
+  w->random ^= w->random << 17;
+  return (int)(w->random % w->s->workers);
+}
+
+/* own work first, then one sweep over the other workers starting at a random one */
+int findTask(int* task, Worker* w) {
+  Scheduler s = w->s;
+  if (popDequeWS(task, s->deques[w->id])) {
+    return 1;
+  }
+  int first = victim(w);
+  for (int i = 0; i < s->workers; i++) {
+    int v = (first + i) % s->workers;
+    if (v != w->id && stealDequeWS(task, s->deques[v])) {
+      w->steals++;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void* workerLoop(void* arg) {
+  Worker* w = arg;
+  Scheduler s = w->s;
+  int task;
+  /* acquire: the last finished task happens before we return */
+  while (atomic_load_explicit(&s->pending, memory_order_acquire) > 0) {
+    if (findTask(&task, w)) {
+      s->run(task, w->id, s, s->context);
+      atomic_fetch_sub_explicit(&s->pending, 1, memory_order_release);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+void runScheduler(Scheduler s) {
+  pthread_t* threads = malloc(s->workers * sizeof(pthread_t));
+  assert(threads != NULL);
+  /* tasks spawned on a worker without a thread are stolen by the others,
+     and worker 0 runs on the calling thread, so all tasks still run */
+  for (int w = 1; w < s->workers; w++) {
+    s->state[w].onThread = pthread_create(&threads[w], NULL, workerLoop, &s->state[w]) == 0;
+  }
+  workerLoop(&s->state[0]);
+  for (int w = 1; w < s->workers; w++) {
+    if (s->state[w].onThread) {
+      pthread_join(threads[w], NULL);
+    }
+  }
+  free(threads);
+}
+
+long stealsScheduler(Scheduler s) {
+  long steals = 0;
+  for (int w = 0; w < s->workers; w++) {
+    steals += s->state[w].steals;
+  }
+  return steals;
+}
+
+void freeScheduler(Scheduler s) {
+  for (int w = 0; w < s->workers; w++) {
+    freeDequeWS(s->deques[w]);
+  }
+  free(s->deques);
+  free(s->state);
+  free(s);
+}
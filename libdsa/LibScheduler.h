@@ -0,0 +1,30 @@
+#ifndef LIBSCHEDULER_H
+#define LIBSCHEDULER_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Work-stealing scheduler for tasks that are ints. Every worker owns a
+ * DequeWS: it runs its own newest task first and, when it has none,
+ * steals the oldest task of a random other worker. A task may spawn
+ * more tasks; the run ends when every spawned task has finished.
+ */
+typedef struct SchedulerS* Scheduler;
+
+/* runs one task on worker number worker (0 .. workers-1) */
+typedef void (*TaskFunction)(int task, int worker, Scheduler s, void* context);
+
+Scheduler newScheduler(int workers, TaskFunction run, void* context);
+
+/* from inside a task running on worker, or from the main thread with worker 0 before runScheduler */
+void spawnTask(int task, int worker, Scheduler s);
+
+/* the calling thread becomes worker 0; returns when all tasks are done */
+void runScheduler(Scheduler s);
+
+long stealsScheduler(Scheduler s);
+void freeScheduler(Scheduler s);
+
+#endif
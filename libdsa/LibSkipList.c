@@ -0,0 +1,200 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibList.h"
+#include "LibSkipList.h"
+
+#define MAX_LEVEL 32
+#define CHUNK_SIZE 65536 /* nodes are carved from chunks of this size */
+
+struct SkipNode {
+  int item;
+  int height;
+  SkipNode* next[];  // one per level, height of them
+};
+
+typedef struct SkipChunk {
+  struct SkipChunk* next;
+} SkipChunk;
+
+typedef struct SkipListS {
+  SkipNode* head;  // sentinel with MAX_LEVEL levels
+  int level;       // levels in use
+  int length;
+  uint64_t rng;
+  // the pool: one free list per height, and the unused rest of the
+  // newest chunk
+  SkipNode* freeNodes[MAX_LEVEL + 1];
+  SkipChunk* chunks;
+  char* fresh;
+  size_t freshBytes;  // left after fresh; 0 before the first chunk
+} SkipListS;
+
+static size_t nodeSize(int height) {
+  return sizeof(SkipNode) + height * sizeof(SkipNode*);
+}
+
+static SkipNode* newNode(SkipList s, int height, int item) {
+  SkipNode* node = s->freeNodes[height];
+  if (node != NULL) {
+    s->freeNodes[height] = node->next[0];
+  } else {
+    if (s->freshBytes < nodeSize(height)) {
+      SkipChunk* chunk = malloc(CHUNK_SIZE);
+      assert(chunk != NULL);
+      chunk->next = s->chunks;
+      s->chunks = chunk;
+      s->fresh = (char*)(chunk + 1);
+      s->freshBytes = CHUNK_SIZE - sizeof(SkipChunk);
+    }
+    node = (SkipNode*)s->fresh;
+    s->fresh += nodeSize(height);
+    s->freshBytes -= nodeSize(height);
+  }
+  node->item = item;
+  node->height = height;
+  return node;
+}
+
+static void freeNode(SkipList s, SkipNode* node) {
+  node->next[0] = s->freeNodes[node->height];
+  s->freeNodes[node->height] = node;
+}
+
+/*
+ * @brief A height of 1, 2, 3, ... with probability 3/4, 3/16, 3/64, ...
+ * from a xorshift64* generator
+ */
+static int randomHeight(SkipList s) {
+  s->rng ^= s->rng >> 12;
+  s->rng ^= s->rng << 25;
+  s->rng ^= s->rng >> 27;
+  uint64_t r = s->rng * 2685821657736338717ull;
+  int height = 1 + __builtin_ctzll(r | 1ull << 62) / 2;
+  return height < MAX_LEVEL ? height : MAX_LEVEL;
+}
+
+SkipList newSkipList(uint64_t seed) {
+  SkipList s = calloc(1, sizeof(SkipListS));
+  assert(s != NULL);
+  s->rng = seed * 0x9E3779B97F4A7C15ull + 1;  // never 0
+  s->head = malloc(nodeSize(MAX_LEVEL));
+  assert(s->head != NULL);
+  s->head->height = MAX_LEVEL;
+  for (int i = 0; i < MAX_LEVEL; i++) {
+    s->head->next[i] = NULL;
+  }
+  s->level = 1;
+  return s;
+}
+
+int isEmptySkip(SkipList s) {
+  return s->length == 0;
+}
+
+int lengthSkip(SkipList s) {
+  return s->length;
+}
+
+/*
+ * @brief Fills before[i] with the last node on level i whose item is
+ * smaller than n (orEqual: smaller than or equal to n)
+ */
+static void findBefore(SkipList s, int n, int orEqual, SkipNode** before) {
+  SkipNode* p = s->head;
+  for (int i = s->level - 1; i >= 0; i--) {
+    SkipNode* q;
+    while ((q = p->next[i]) != NULL && (q->item < n || (orEqual && q->item == n))) {
+      p = q;
+    }
+    before[i] = p;
+  }
+}
+
+void insertSkip(int n, SkipList s) {
+  SkipNode* before[MAX_LEVEL];
+  findBefore(s, n, 1, before);  // after the equal items already there
+  int height = randomHeight(s);
+  while (s->level < height) {
+    before[s->level++] = s->head;
+  }
+  SkipNode* node = newNode(s, height, n);
+  for (int i = 0; i < height; i++) {
+    node->next[i] = before[i]->next[i];
+    before[i]->next[i] = node;
+  }
+  s->length++;
+}
+
+int isInSkip(int n, SkipList s) {
+  SkipNode* p = s->head;
+  for (int i = s->level - 1; i >= 0; i--) {
+    while (p->next[i] != NULL && p->next[i]->item < n) {
+      p = p->next[i];
+    }
+  }
+  return p->next[0] != NULL && p->next[0]->item == n;
+}
+
+/*
+ * @brief Removes the first occurrence of n
+ * @return 1 if n was in the list, 0 if not
+ */
+int removeSkip(int n, SkipList s) {
+  SkipNode* before[MAX_LEVEL];
+  findBefore(s, n, 0, before);
+  SkipNode* node = before[0]->next[0];
+  if (node == NULL || node->item != n) {
+    return 0;
+  }
+  for (int i = 0; i < node->height; i++) {
+    before[i]->next[i] = node->next[i];
+  }
+  while (s->level > 1 && s->head->next[s->level - 1] == NULL) {
+    s->level--;
+  }
+  freeNode(s, node);
+  s->length--;
+  return 1;
+}
+
+int firstItemSkip(SkipList s) {
+  if (s->head->next[0] == NULL) {
+    listEmptyError();
+  }
+  return s->head->next[0]->item;
+}
+
+SkipNode* firstSkip(SkipList s) {
+  return s->head->next[0];
+}
+
+SkipNode* nextSkip(SkipNode* p) {
+  return p->next[0];
+}
+
+int itemSkip(SkipNode* p) {
+  return p->item;
+}
+
+void printSkip(SkipList s) {
+  for (SkipNode* p = firstSkip(s); p != NULL; p = nextSkip(p)) {
+    printf("%d ", p->item);
+  }
+}
+
+/*
+ * @brief Frees the list with one free per chunk of nodes
+ */
+void freeSkipList(SkipList s) {
+  SkipChunk* chunk = s->chunks;
+  while (chunk != NULL) {
+    SkipChunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  free(s->head);
+  free(s);
+}
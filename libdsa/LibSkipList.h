@@ -0,0 +1,37 @@
+#ifndef LIBSKIPLIST_H
+#define LIBSKIPLIST_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Ordered list of ints, like a List kept sorted with insertInOrder, but
+ * with expected O(log n) insert, search and remove. Every node is linked
+ * on level 0 and, with probability 1/4 for each further level, on
+ * levels above it, so searches skip ahead on the higher levels. The
+ * levels are drawn from a generator seeded by newSkipList, so the same
+ * seed gives the same list. Nodes come from a pool owned by the list.
+ * Equal items are allowed and kept in insertion order.
+ */
+typedef struct SkipNode SkipNode;
+typedef struct SkipListS* SkipList;
+
+SkipList newSkipList(uint64_t seed);
+
+int isEmptySkip(SkipList s);
+int lengthSkip(SkipList s);
+void insertSkip(int n, SkipList s);
+int isInSkip(int n, SkipList s);
+int removeSkip(int n, SkipList s);
+int firstItemSkip(SkipList s);
+void printSkip(SkipList s);
+void freeSkipList(SkipList s);
+
+// in-order iteration: for (SkipNode* p = firstSkip(s); p != NULL; p = nextSkip(p))
+SkipNode* firstSkip(SkipList s);
+SkipNode* nextSkip(SkipNode* p);
+int itemSkip(SkipNode* p);
+
+#endif
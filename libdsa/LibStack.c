@@ -0,0 +1,51 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibStack.h"
+#include "LibStackTemplate.h"
+
+/* the int stack is the template instantiated for the opaque struct StackS */
+DEFINE_STACK(StackS, int)
+
+const int INITIAL_STACK_SIZE = 7;
+
+Stack newStack(void) {
+  return newStackS(INITIAL_STACK_SIZE);
+}
+
+int isEmptyStack(Stack st) {
+  return isEmptyStackS(st);
+}
+
+int lengthStack(Stack st) {
+  return lengthStackS(st);
+}
+
+void push(int value, Stack st) {
+  pushStackS(value, st);
+}
+
+int pop(Stack st) {
+  return popStackS(st);
+}
+
+/* the stack will not shrink below capacity until shrinkStackToFit */
+void reserveStack(int capacity, Stack st) {
+  reserveStackS(capacity, st);
+}
+
+void shrinkStackToFit(Stack st) {
+  shrinkToFitStackS(st);
+}
+
+/* removes all items but keeps the storage for reuse */
+void clearStack(Stack st) {
+  clearStackS(st);
+}
+
+void freeStack(Stack st) {
+  freeStackS(st);
+}
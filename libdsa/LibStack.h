@@ -15,6 +15,11 @@ void push(int value, Stack st);
 int pop(Stack st);
 
 int isEmptyStack(Stack st);
+int lengthStack(Stack st);
+
+void reserveStack(int capacity, Stack st);
+void shrinkStackToFit(Stack st);
+void clearStack(Stack st);
 void freeStack(Stack st);
 
 #endif
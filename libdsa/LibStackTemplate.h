@@ -0,0 +1,125 @@
+#ifndef LIBSTACKTEMPLATE_H
+#define LIBSTACKTEMPLATE_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * DEFINE_STACK(Name, T) defines a LIFO stack type Name that stores items of
+ * type T by value in a growable array, together with these functions:
+ *
+ *   Name* newName(int capacity);   capacity is a hint, 0 for the default
+ *   void pushName(T value, Name* st);
+ *   T popName(Name* st);           aborts if the stack is empty
+ *   int isEmptyName(Name* st);
+ *   int lengthName(Name* st);
+ *   void reserveName(int capacity, Name* st);   never shrinks below capacity
+ *   void shrinkToFitName(Name* st);   just enough room for the items
+ *   void clearName(Name* st);      empties the stack, keeps the array
+ *   void freeName(Name* st);
+ *
+ * Like the queue, the array doubles when it is full and halves when less
+ * than a quarter of it is used, down to the capacity given to newName or
+ * reserveName.
+ *
+ * All functions are static inline, so the compiler can inline them at
+ * every call site. Use it once per item type, at file scope.
+ */
+#define MIN_STACK_SIZE 7
+
+#define DEFINE_STACK(Name, T)                                            \
+  typedef struct Name {                                                  \
+    T* array;                                                            \
+    int top;                                                             \
+    int size;                                                            \
+    int minSize;                                                         \
+  } Name;                                                                \
+                                                                         \
+  static inline Name* new##Name(int capacity) {                          \
+    Name* st = malloc(sizeof(Name));                                     \
+    assert(st != NULL);                                                  \
+    st->size = capacity > 0 ? capacity : MIN_STACK_SIZE;                 \
+    st->minSize = st->size;                                              \
+    st->array = malloc(st->size * sizeof(T));                            \
+    assert(st->array != NULL);                                           \
+    st->top = 0;                                                         \
+    return st;                                                           \
+  }                                                                      \
+                                                                         \
+  static inline void resize##Name(int newSize, Name* st) {               \
+    st->array = realloc(st->array, newSize * sizeof(T));                 \
+    assert(st->array != NULL);                                           \
+    st->size = newSize;                                                  \
+  }                                                                      \
+                                                                         \
+  static inline void doubleSize##Name(Name* st) {                        \
+    resize##Name(2 * st->size, st);                                      \
+  }                                                                      \
+                                                                         \
+  /* halve (repeatedly) while less than a quarter is used */             \
+  static inline void shrink##Name(Name* st) {                            \
+    int newSize = st->size;                                              \
+    while (st->top < newSize / 4 && newSize / 2 >= st->minSize) {        \
+      newSize /= 2;                                                      \
+    }                                                                    \
+    if (newSize != st->size) {                                           \
+      resize##Name(newSize, st);                                         \
+    }                                                                    \
+  }                                                                      \
+                                                                         \
+  static inline int isEmpty##Name(Name* st) {                            \
+    return (st->top == 0);                                               \
+  }                                                                      \
+                                                                         \
+  static inline int length##Name(Name* st) {                             \
+    return st->top;                                                      \
+  }                                                                      \
+                                                                         \
+  static inline void push##Name(T value, Name* st) {                     \
+    if (st->top == st->size) {                                           \
+      doubleSize##Name(st);                                              \
+    }                                                                    \
+    st->array[st->top] = value;                                          \
+    st->top++;                                                           \
+  }                                                                      \
+                                                                         \
+  static inline T pop##Name(Name* st) {                                  \
+    if (isEmpty##Name(st)) {                                             \
+      printf("stack empty\n");                                           \
+      abort();                                                           \
+    }                                                                    \
+    st->top--;                                                           \
+    T value = st->array[st->top];                                        \
+    if (st->top < st->size / 4 && st->size / 2 >= st->minSize) {         \
+      shrink##Name(st);                                                  \
+    }                                                                    \
+    return value;                                                        \
+  }                                                                      \
+                                                                         \
+  static inline void reserve##Name(int capacity, Name* st) {             \
+    st->minSize = capacity > MIN_STACK_SIZE ? capacity : MIN_STACK_SIZE; \
+    if (st->size < st->minSize) {                                        \
+      resize##Name(st->minSize, st);                                     \
+    }                                                                    \
+  }                                                                      \
+                                                                         \
+  /* also drops the capacity given to new or reserve */                  \
+  static inline void shrinkToFit##Name(Name* st) {                       \
+    st->minSize = MIN_STACK_SIZE;                                        \
+    int size = st->top > MIN_STACK_SIZE ? st->top : MIN_STACK_SIZE;      \
+    if (size != st->size) {                                              \
+      resize##Name(size, st);                                            \
+    }                                                                    \
+  }                                                                      \
+                                                                         \
+  static inline void clear##Name(Name* st) {                             \
+    st->top = 0;                                                         \
+  }                                                                      \
+                                                                         \
+  static inline void free##Name(Name* st) {                              \
+    free(st->array);                                                     \
+    free(st);                                                            \
+  }
+
+#endif
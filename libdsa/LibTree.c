@@ -0,0 +1,209 @@
+/* by Malvin Gattinger */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibTree.h"
+
+// an AVL tree of height 96 has more than 2^64 nodes; a deeper path means
+// the tree was unbalanced by other code, and is then not rebalanced
+#define MAX_TREE_HEIGHT 96
+
+Tree emptyTree(void) {
+  return NULL;
+}
+
+Tree newTree(int n, Tree tL, Tree tR) {
+  Tree new = malloc(sizeof(struct TreeNode));
+  assert(new != NULL);
+  new->item = n;
+  new->height = 1 + (heightTree(tL) > heightTree(tR) ? heightTree(tL) : heightTree(tR));
+  new->leftChild = tL;
+  new->rightChild = tR;
+  return new;
+}
+
+void preOrder(Tree t) {
+  if (t == NULL) {
+    return;
+  }
+  printf("%d\n", t->item);
+  preOrder(t->leftChild);
+  preOrder(t->rightChild);
+}
+
+void postOrder(Tree t) {
+  if (t == NULL) {
+    return;
+  }
+  postOrder(t->leftChild);
+  postOrder(t->rightChild);
+  printf("%d\n", t->item);
+}
+
+void inOrder(Tree t) {
+  if (t == NULL) {
+    return;
+  }
+  inOrder(t->leftChild);
+  printf("%d\n", t->item);
+  inOrder(t->rightChild);
+}
+
+/*
+ * Rotates left children up until the node has none, then frees it, so
+ * even a tree degenerated into a list is freed without recursion.
+ */
+void freeTree(Tree t) {
+  while (t != NULL) {
+    Tree l = t->leftChild;
+    if (l != NULL) {
+      t->leftChild = l->rightChild;
+      l->rightChild = t;
+      t = l;
+    } else {
+      Tree r = t->rightChild;
+      free(t);
+      t = r;
+    }
+  }
+}
+
+Tree searchNode(Tree t, int n) {
+  while (t != NULL && n != t->item) {
+    t = (n < t->item ? t->leftChild : t->rightChild);
+  }
+  return t;
+}
+
+int heightTree(Tree t) {
+  return t == NULL ? 0 : t->height;
+}
+
+static void updateHeight(Tree t) {
+  int hL = heightTree(t->leftChild);
+  int hR = heightTree(t->rightChild);
+  t->height = 1 + (hL > hR ? hL : hR);
+}
+
+static Tree rotateRight(Tree t) {
+  Tree l = t->leftChild;
+  t->leftChild = l->rightChild;
+  l->rightChild = t;
+  updateHeight(t);
+  updateHeight(l);
+  return l;
+}
+
+static Tree rotateLeft(Tree t) {
+  Tree r = t->rightChild;
+  t->rightChild = r->leftChild;
+  r->leftChild = t;
+  updateHeight(t);
+  updateHeight(r);
+  return r;
+}
+
+/*
+ * @brief Restores the AVL property at t, whose subtrees are AVL trees
+ * with heights differing by at most two
+ * @return The new root of the subtree
+ */
+static Tree rebalance(Tree t) {
+  int balance = heightTree(t->leftChild) - heightTree(t->rightChild);
+  if (balance > 1) {
+    if (heightTree(t->leftChild->leftChild) < heightTree(t->leftChild->rightChild)) {
+      t->leftChild = rotateLeft(t->leftChild);
+    }
+    return rotateRight(t);
+  }
+  if (balance < -1) {
+    if (heightTree(t->rightChild->rightChild) < heightTree(t->rightChild->leftChild)) {
+      t->rightChild = rotateRight(t->rightChild);
+    }
+    return rotateLeft(t);
+  }
+  updateHeight(t);
+  return t;
+}
+
+/*
+ * @brief Rebalances the subtrees on the path bottom-up, stopping at the
+ * first one whose height did not change: nothing above it changed either
+ *
+ * @param path Links from the root down to the changed subtree
+ * @param depth Number of links in path
+ */
+static void rebalancePath(Tree** path, int depth) {
+  while (depth > 0) {
+    Tree* link = path[--depth];
+    int old = (*link)->height;
+    *link = rebalance(*link);
+    if ((*link)->height == old) {
+      return;
+    }
+  }
+}
+
+Tree addInSearchTree(Tree t, int n) {
+  Tree* path[MAX_TREE_HEIGHT];
+  int depth = 0;
+  Tree* link = &t;
+  while (*link != NULL) {
+    if (n == (*link)->item) {
+      return t;
+    }
+    if (depth < MAX_TREE_HEIGHT) {
+      path[depth] = link;
+    }
+    depth++;
+    link = (n < (*link)->item ? &(*link)->leftChild : &(*link)->rightChild);
+  }
+  *link = newTree(n, emptyTree(), emptyTree());
+  if (depth <= MAX_TREE_HEIGHT) {
+    rebalancePath(path, depth);
+  }
+  return t;
+}
+
+Tree removeInSearchTree(Tree t, int n) {
+  Tree* path[MAX_TREE_HEIGHT];
+  int depth = 0;
+  Tree* link = &t;
+  while (*link != NULL && n != (*link)->item) {
+    if (depth < MAX_TREE_HEIGHT) {
+      path[depth] = link;
+    }
+    depth++;
+    link = (n < (*link)->item ? &(*link)->leftChild : &(*link)->rightChild);
+  }
+  if (*link == NULL) {
+    return t;
+  }
+  // a node with two children takes the item of its in-order successor,
+  // which is removed instead
+  Tree found = *link;
+  if (found->leftChild != NULL && found->rightChild != NULL) {
+    if (depth < MAX_TREE_HEIGHT) {
+      path[depth] = link;
+    }
+    depth++;
+    link = &found->rightChild;
+    while ((*link)->leftChild != NULL) {
+      if (depth < MAX_TREE_HEIGHT) {
+        path[depth] = link;
+      }
+      depth++;
+      link = &(*link)->leftChild;
+    }
+    found->item = (*link)->item;
+  }
+  Tree removed = *link;
+  *link = (removed->leftChild != NULL ? removed->leftChild : removed->rightChild);
+  free(removed);
+  if (depth <= MAX_TREE_HEIGHT) {
+    rebalancePath(path, depth);
+  }
+  return t;
+}
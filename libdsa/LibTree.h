@@ -0,0 +1,43 @@
+/* by Gerard Renardel and Malvin Gattinger */
+
+#ifndef LIBTREE_H
+#define LIBTREE_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct TreeNode* Tree;
+
+struct TreeNode {
+  int item;
+  int height;  // of the subtree, a leaf has 1; set by newTree and the search tree functions
+  Tree leftChild;
+  Tree rightChild;
+};
+
+Tree emptyTree(void);
+
+Tree newTree(int n, Tree tL, Tree tR);
+
+void preOrder(Tree t);
+void postOrder(Tree t);
+void inOrder(Tree t);
+
+void freeTree(Tree t);
+
+/*
+ * addInSearchTree and removeInSearchTree keep a search tree AVL balanced:
+ * the heights of two siblings differ by at most one, so even sorted
+ * input gives a tree of height below 1.45 log2(n). Both work without
+ * recursion and return the new root. A tree changed by other code, like
+ * a hand-written removal that does not update height, stays a valid
+ * search tree under them, but is only rebalanced as far as its heights
+ * are right.
+ */
+Tree searchNode(Tree t, int n);
+Tree addInSearchTree(Tree t, int n);
+Tree removeInSearchTree(Tree t, int n);
+int heightTree(Tree t);
+
+#endif
@@ -0,0 +1,314 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "LibList.h"
+#include "LibUnrolledList.h"
+
+#define UNROLLED_CAPACITY 28 /* 128-byte nodes */
+#define UNROLLED_HALF (UNROLLED_CAPACITY / 2)
+
+typedef struct UnrolledNode {
+  struct UnrolledNode* next;
+  int count;
+  int items[UNROLLED_CAPACITY];
+} UnrolledNode;
+
+typedef struct UnrolledListS {
+  UnrolledNode* head;
+  UnrolledNode* tail;
+  int length;
+} UnrolledListS;
+
+UnrolledList newUnrolledList(void) {
+  UnrolledList u = malloc(sizeof(UnrolledListS));
+  assert(u != NULL);
+  u->head = u->tail = NULL;
+  u->length = 0;
+  return u;
+}
+
+int isEmptyUnrolled(UnrolledList u) {
+  return u->length == 0;
+}
+
+int lengthUnrolled(UnrolledList u) {
+  return u->length;
+}
+
+/*
+ * @brief Links a new empty node in after prev, or in front if prev is NULL
+ */
+static UnrolledNode* newNodeAfter(UnrolledList u, UnrolledNode* prev) {
+  UnrolledNode* node = malloc(sizeof(UnrolledNode));
+  assert(node != NULL);
+  node->count = 0;
+  if (prev == NULL) {
+    node->next = u->head;
+    u->head = node;
+  } else {
+    node->next = prev->next;
+    prev->next = node;
+  }
+  if (node->next == NULL) {
+    u->tail = node;
+  }
+  return node;
+}
+
+static void insertInNode(UnrolledNode* node, int i, int n) {
+  if (i < node->count) {
+    memmove(node->items + i + 1, node->items + i, (node->count - i) * sizeof(int));
+  }
+  node->items[i] = n;
+  node->count++;
+}
+
+/*
+ * @brief Inserts n at position p of node; prev is the node before it
+ *
+ * A full node is split in halves, except that a full first (last) node
+ * gets a new node in front of (after) it when n goes to its very start
+ * (end), so building a list at either end leaves its nodes full.
+ */
+static void insertAt(UnrolledList u, UnrolledNode* prev, UnrolledNode* node, int p, int n) {
+  if (node->count == UNROLLED_CAPACITY) {
+    if (p == UNROLLED_CAPACITY && node->next != NULL && node->next->count < UNROLLED_CAPACITY) {
+      node = node->next;
+      p = 0;
+    } else if (p == 0 && prev == NULL) {
+      node = newNodeAfter(u, NULL);
+    } else if (p == UNROLLED_CAPACITY && node->next == NULL) {
+      node = newNodeAfter(u, node);
+      p = 0;
+    } else {
+      UnrolledNode* right = newNodeAfter(u, node);
+      memcpy(right->items, node->items + UNROLLED_HALF, (UNROLLED_CAPACITY - UNROLLED_HALF) * sizeof(int));
+      right->count = UNROLLED_CAPACITY - UNROLLED_HALF;
+      node->count = UNROLLED_HALF;
+      if (p > UNROLLED_HALF) {
+        node = right;
+        p -= UNROLLED_HALF;
+      }
+    }
+  }
+  insertInNode(node, p, n);
+  u->length++;
+}
+
+void addItemAtPosUnrolled(UnrolledList u, int n, int p) {
+  if (p < 0 || p > u->length) {
+    listTooShort();
+  }
+  if (u->head == NULL) {
+    insertInNode(newNodeAfter(u, NULL), 0, n);
+    u->length++;
+    return;
+  }
+  if (p == u->length) {
+    // prev only matters at position 0, and the tail is never empty
+    insertAt(u, NULL, u->tail, u->tail->count, n);
+    return;
+  }
+  // the first node that reaches position p, so p == 0 only in the first node
+  UnrolledNode* prev = NULL;
+  UnrolledNode* node = u->head;
+  while (p > node->count) {
+    p -= node->count;
+    prev = node;
+    node = node->next;
+  }
+  insertAt(u, prev, node, p, n);
+}
+
+void addItemUnrolled(int n, UnrolledList u) {
+  addItemAtPosUnrolled(u, n, 0);
+}
+
+void appendUnrolled(UnrolledList u, int n) {
+  addItemAtPosUnrolled(u, n, u->length);
+}
+
+int firstItemUnrolled(UnrolledList u) {
+  if (u->head == NULL) {
+    listEmptyError();
+  }
+  return u->head->items[0];
+}
+
+int itemAtPosUnrolled(UnrolledList u, int p) {
+  if (p < 0 || p >= u->length) {
+    listTooShort();
+  }
+  UnrolledNode* node = u->head;
+  while (p >= node->count) {
+    p -= node->count;
+    node = node->next;
+  }
+  return node->items[p];
+}
+
+/*
+ * @brief Removes the item at index i of node; prev is the node before it
+ *
+ * An emptied node is freed. A middle node that drops below half full
+ * takes all items of the next node if they fit, otherwise enough of
+ * them to leave both nodes at least half full.
+ */
+static void removeAt(UnrolledList u, UnrolledNode* prev, UnrolledNode* node, int i) {
+  memmove(node->items + i, node->items + i + 1, (node->count - i - 1) * sizeof(int));
+  node->count--;
+  u->length--;
+  if (node->count == 0) {
+    if (prev == NULL) {
+      u->head = node->next;
+    } else {
+      prev->next = node->next;
+    }
+    if (u->tail == node) {
+      u->tail = prev;
+    }
+    free(node);
+    return;
+  }
+  UnrolledNode* next = node->next;
+  if (prev == NULL || next == NULL || node->count >= UNROLLED_HALF) {
+    return;
+  }
+  if (node->count + next->count <= UNROLLED_CAPACITY) {
+    memcpy(node->items + node->count, next->items, next->count * sizeof(int));
+    node->count += next->count;
+    node->next = next->next;
+    if (u->tail == next) {
+      u->tail = node;
+    }
+    free(next);
+  } else {
+    int k = (next->count - node->count) / 2;
+    memcpy(node->items + node->count, next->items, k * sizeof(int));
+    memmove(next->items, next->items + k, (next->count - k) * sizeof(int));
+    node->count += k;
+    next->count -= k;
+  }
+}
+
+void removeFirstUnrolled(UnrolledList u) {
+  if (u->head == NULL) {
+    listEmptyError();
+  }
+  removeAt(u, NULL, u->head, 0);
+}
+
+/*
+ * @brief Returns the index of the first n in node, or -1
+ */
+static int findInNode(const UnrolledNode* node, int n) {
+  int i = 0;
+#if defined(__AVX2__)
+  __m256i key8 = _mm256_set1_epi32(n);
+  for (; i + 8 <= node->count; i += 8) {
+    __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(node->items + i)), key8);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  __m128i key4 = _mm_set1_epi32(n);
+  for (; i + 4 <= node->count; i += 4) {
+    __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(node->items + i)), key4);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; i < node->count; i++) {
+    if (node->items[i] == n) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void removeItemUnrolled(UnrolledList u, int n) {
+  UnrolledNode* prev = NULL;
+  for (UnrolledNode* node = u->head; node != NULL; prev = node, node = node->next) {
+    int i = findInNode(node, n);
+    if (i >= 0) {
+      removeAt(u, prev, node, i);
+      return;
+    }
+  }
+}
+
+int isInUnrolled(int n, UnrolledList u) {
+  for (UnrolledNode* node = u->head; node != NULL; node = node->next) {
+    if (findInNode(node, n) >= 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * @brief Sum of all items, wrapping around like int additions usually do
+ */
+int sumUnrolled(UnrolledList u) {
+  unsigned int sum = 0;
+#if defined(__AVX2__)
+  __m256i sum8 = _mm256_setzero_si256();
+#endif
+#if defined(__SSE2__)
+  __m128i sum4 = _mm_setzero_si128();
+#endif
+  for (UnrolledNode* node = u->head; node != NULL; node = node->next) {
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= node->count; i += 8) {
+      sum8 = _mm256_add_epi32(sum8, _mm256_loadu_si256((const __m256i*)(node->items + i)));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 4 <= node->count; i += 4) {
+      sum4 = _mm_add_epi32(sum4, _mm_loadu_si128((const __m128i*)(node->items + i)));
+    }
+#endif
+    for (; i < node->count; i++) {
+      sum += (unsigned int)node->items[i];
+    }
+  }
+#if defined(__AVX2__)
+  sum4 = _mm_add_epi32(sum4, _mm256_castsi256_si128(sum8));
+  sum4 = _mm_add_epi32(sum4, _mm256_extracti128_si256(sum8, 1));
+#endif
+#if defined(__SSE2__)
+  unsigned int lanes[4];
+  _mm_storeu_si128((__m128i*)lanes, sum4);
+  sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+  return (int)sum;
+}
+
+void printUnrolled(UnrolledList u) {
+  for (UnrolledNode* node = u->head; node != NULL; node = node->next) {
+    for (int i = 0; i < node->count; i++) {
+      printf("%d ", node->items[i]);
+    }
+  }
+}
+
+void freeUnrolledList(UnrolledList u) {
+  UnrolledNode* node = u->head;
+  while (node != NULL) {
+    UnrolledNode* next = node->next;
+    free(node);
+    node = next;
+  }
+  free(u);
+}
@@ -0,0 +1,33 @@
+#ifndef LIBUNROLLEDLIST_H
+#define LIBUNROLLEDLIST_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * List of ints whose 128-byte nodes hold up to 28 items each, so a
+ * traversal misses the cache about twice per 28 items instead of once
+ * per item. Every node but the first and the last is at least half full.
+ * Searching and summing scan the items of a node with SSE2 or AVX2 when
+ * the library is built for them.
+ */
+typedef struct UnrolledListS* UnrolledList;
+
+UnrolledList newUnrolledList(void);
+
+int isEmptyUnrolled(UnrolledList u);
+int lengthUnrolled(UnrolledList u);
+void addItemUnrolled(int n, UnrolledList u);
+int firstItemUnrolled(UnrolledList u);
+void removeFirstUnrolled(UnrolledList u);
+int itemAtPosUnrolled(UnrolledList u, int p);
+void addItemAtPosUnrolled(UnrolledList u, int n, int p);
+void appendUnrolled(UnrolledList u, int n);
+void removeItemUnrolled(UnrolledList u, int n);
+int isInUnrolled(int n, UnrolledList u);
+int sumUnrolled(UnrolledList u);
+void printUnrolled(UnrolledList u);
+void freeUnrolledList(UnrolledList u);
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file  benchdsa.c
+ * @brief One benchmark for every container in libdsa, so a change to the
+ * library is measured in one place. The Makefile builds it once per
+ * -march variant of the library.
+ *
+ * usage: benchdsa [SCALE]   (default 1: 10^7 operations per line)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LibDeque.h"
+#include "LibDequeWS.h"
+#include "LibList.h"
+#include "LibQueue.h"
+#include "LibQueueMPMC.h"
+#include "LibQueueSPSC.h"
+#include "LibScheduler.h"
+#include "LibStack.h"
+#include "LibTree.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+double started;
+void start(void) {
+  started = now();
+}
+
+void report(const char* container, const char* workload, long ops, long checksum) {
+  double seconds = now() - started;
+  printf("%-10s %-34s %8.2f ns/op %9.1f Mops/s   (checksum %ld)\n", container, workload, seconds * 1e9 / ops,
+         ops / seconds * 1e-6, checksum);
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+void benchList(long n) {
+  long checksum = 0;
+  start();
+  List li = newEmptyList();
+  for (long i = 0; i < n; i++) {
+    li = addItem((int)i, li);
+  }
+  for (List p = li; !isEmptyList(p); p = p->next) {
+    checksum += p->item;
+  }
+  while (!isEmptyList(li)) {
+    li = removeFirstNode(li);
+  }
+  report("List", "addItem, walk, removeFirstNode", 3 * n, checksum);
+}
+
+void benchTree(long n) {
+  uint64_t x = 88172645463325252u;
+  long checksum = 0;
+  start();
+  Tree t = emptyTree();
+  for (long i = 0; i < n; i++) {
+    t = addInSearchTree(t, (int)(xorshift(&x) % (4 * n)));
+  }
+  for (long i = 0; i < n; i++) {
+    checksum += searchNode(t, (int)(xorshift(&x) % (4 * n))) != NULL;
+  }
+  freeTree(t);
+  report("Tree", "random insert + search", 2 * n, checksum);
+}
+
+void benchQueue(long n) {
+  long checksum = 0;
+  start();
+  Queue q = newQueue();
+  for (long i = 0; i < n; i++) {
+    enqueue((int)i, q);
+  }
+  while (!isEmptyQueue(q)) {
+    checksum += dequeue(q);
+  }
+  freeQueue(q);
+  report("Queue", "burst enqueue + dequeue", 2 * n, checksum);
+
+  int buffer[256];
+  checksum = 0;
+  start();
+  q = newQueue();
+  for (long i = 0; i < n / 256; i++) {
+    for (int j = 0; j < 256; j++) {
+      buffer[j] = (int)(i + j);
+    }
+    enqueueMany(buffer, 256, q);
+  }
+  while (!isEmptyQueue(q)) {
+    int m = dequeueMany(buffer, 256, q);
+    for (int j = 0; j < m; j++) {
+      checksum += buffer[j];
+    }
+  }
+  freeQueue(q);
+  report("Queue", "burst, bulk of 256", 2 * (n / 256) * 256, checksum);
+}
+
+void benchStack(long n) {
+  long checksum = 0;
+  start();
+  Stack st = newStack();
+  for (long i = 0; i < n; i++) {
+    push((int)i, st);
+  }
+  while (!isEmptyStack(st)) {
+    checksum += pop(st);
+  }
+  freeStack(st);
+  report("Stack", "burst push + pop", 2 * n, checksum);
+}
+
+void benchDeque(long n) {
+  long checksum = 0;
+  start();
+  Deque d = newDeque();
+  for (long i = 0; i < n; i++) {
+    if (i % 2 == 0) {
+      pushBack((int)i, d);
+    } else {
+      pushFront((int)i, d);
+    }
+  }
+  for (long i = 0; i < n; i++) {
+    checksum += i % 2 == 0 ? popFront(d) : popBack(d);
+  }
+  freeDeque(d);
+  report("Deque", "push and pop at both ends", 2 * n, checksum);
+}
+
+typedef struct Pipe {
+  QueueSPSC spsc;
+  QueueMPMC mpmc;
+  long count;
+} Pipe;
+
+void* produceSPSC(void* arg) {
+  Pipe* p = arg;
+  for (long i = 0; i < p->count; i++) {
+    enqueueSPSC((int)i, p->spsc);
+  }
+  return NULL;
+}
+
+void* produceMPMC(void* arg) {
+  Pipe* p = arg;
+  for (long i = 0; i < p->count; i++) {
+    enqueueMPMC((int)i, p->mpmc);
+  }
+  return NULL;
+}
+
+void benchConcurrentQueues(long n) {
+  Pipe p = {newQueueSPSC(4096), newQueueMPMC(4096), n};
+  pthread_t producer;
+  long checksum = 0;
+  start();
+  pthread_create(&producer, NULL, produceSPSC, &p);
+  for (long i = 0; i < n; i++) {
+    checksum += dequeueSPSC(p.spsc);
+  }
+  pthread_join(producer, NULL);
+  report("QueueSPSC", "1 producer -> 1 consumer", n, checksum);
+
+  checksum = 0;
+  start();
+  pthread_create(&producer, NULL, produceMPMC, &p);
+  for (long i = 0; i < n; i++) {
+    checksum += dequeueMPMC(p.mpmc);
+  }
+  pthread_join(producer, NULL);
+  report("QueueMPMC", "1 producer -> 1 consumer", n, checksum);
+  freeQueueSPSC(p.spsc);
+  freeQueueMPMC(p.mpmc);
+}
+
+void fibTask(int n, int worker, Scheduler s, void* context) {
+  long* leaves = context;
+  if (n < 2) {
+    leaves[worker] += n;
+  } else {
+    spawnTask(n - 1, worker, s);
+    spawnTask(n - 2, worker, s);
+  }
+}
+
+void benchWorkStealing(long n) {
+  long checksum = 0;
+  int item;
+  start();
+  DequeWS d = newDequeWS(64);
+  for (long i = 0; i < n; i++) {
+    pushDequeWS((int)i, d);
+  }
+  while (popDequeWS(&item, d)) {
+    checksum += item;
+  }
+  freeDequeWS(d);
+  report("DequeWS", "owner push + pop", 2 * n, checksum);
+
+  /* fib(f) spawns about 2.6 * fib(f) tasks; pick f so that is close to n */
+  int f = 2;
+  for (long a = 1, b = 1; 3 * b < n; f++) {
+    long c = a + b;
+    a = b;
+    b = c;
+  }
+  long leaves[2] = {0, 0};
+  start();
+  Scheduler s = newScheduler(2, fibTask, leaves);
+  spawnTask(f, 0, s);
+  runScheduler(s);
+  checksum = leaves[0] + leaves[1];
+  char workload[64];
+  snprintf(workload, sizeof(workload), "scheduler, 2 workers, fib(%d)", f);
+  report("Scheduler", workload, 2 * checksum, checksum);
+  freeScheduler(s);
+}
+
+int main(int argc, char* argv[]) {
+  long scale = argc > 1 ? atol(argv[1]) : 1;
+  long n = 10000000 * scale;
+  benchList(n);
+  benchTree(n / 10);
+  benchQueue(n);
+  benchStack(n);
+  benchDeque(n);
+  benchConcurrentQueues(n / 10);
+  benchWorkStealing(n);
+  return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file  benchlist.c
+ * @brief Build, traverse and free time and peak RSS of lists whose nodes
+ * come from a ListPool, against nodes malloc'ed one by one (as LibList
+ * does without a pool). Run once per allocator: peak RSS is per process.
+ *
+ * "append" instead builds lists in order: with addItemAtPos at the end
+ * (quadratic, so only for a few thousand nodes), with a ListHandle, and
+ * with listFromArray. Then it uses the positional functions at the far
+ * end of the long list; they used to recurse once per node.
+ *
+ * usage: benchlist pool|malloc|append [NODES]   (default 10^7)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "LibList.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long peakRssMiB(void) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+int usePool;
+
+List mallocAddItem(int n, List li) {
+  List node = malloc(sizeof(struct ListNode));
+  node->item = n;
+  node->next = li;
+  return node;
+}
+
+void mallocFreeList(List li) {
+  while (li != NULL) {
+    List next = li->next;
+    free(li);
+    li = next;
+  }
+}
+
+List add(int n, List li) {
+  return usePool ? addItem(n, li) : mallocAddItem(n, li);
+}
+
+long sumList(List li) {
+  long sum = 0;
+  for (; li != NULL; li = li->next) {
+    sum += li->item;
+  }
+  return sum;
+}
+
+/*
+ * @brief Adds nodes items to lists lists (all of them when lists is 1,
+ * otherwise to random ones, like adjacency lists), sums and frees them
+ */
+void bench(const char* name, long nodes, long lists) {
+  uint64_t x = 88172645463325252u;
+  List* li = malloc(lists * sizeof(List));
+  ListPool* pool = usePool ? newListPool() : NULL;
+  ListPool* previous = useListPool(pool);
+
+  double t0 = now();
+  for (long i = 0; i < lists; i++) {
+    li[i] = newEmptyList();
+  }
+  for (long i = 0; i < nodes; i++) {
+    long l = lists == 1 ? 0 : (long)(xorshift(&x) % lists);
+    li[l] = add((int)i, li[l]);
+  }
+  double t1 = now();
+  long checksum = 0;
+  for (long i = 0; i < lists; i++) {
+    checksum += sumList(li[i]);
+  }
+  double t2 = now();
+  if (usePool) {
+    freeListPool(pool);
+  } else {
+    for (long i = 0; i < lists; i++) {
+      mallocFreeList(li[i]);
+    }
+  }
+  double t3 = now();
+  useListPool(previous);
+  free(li);
+
+  printf("%-6s %-22s build %6.2f  traverse %6.2f  free %6.2f ns/node   (checksum %ld)\n", usePool ? "pool" : "malloc",
+         name, (t1 - t0) * 1e9 / nodes, (t2 - t1) * 1e9 / nodes, (t3 - t2) * 1e9 / nodes, checksum);
+}
+
+void benchAppend(int nodes) {
+  int small = nodes < 20000 ? nodes : 20000;
+  double t = now();
+  List li = newEmptyList();
+  for (int i = 0; i < small; i++) {
+    li = addItemAtPos(li, i, i);
+  }
+  printf("%-36s %8d nodes %8.2f ns/node   (checksum %ld)\n", "addItemAtPos at the end", small, (now() - t) * 1e9 / small,
+         sumList(li));
+  freeList(li);
+
+  t = now();
+  ListHandle h = newListHandle();
+  for (int i = 0; i < nodes; i++) {
+    appendItem(i, h);
+  }
+  printf("%-36s %8d nodes %8.2f ns/node   (checksum %ld)\n", "appendItem", nodes, (now() - t) * 1e9 / nodes,
+         sumList(h->head) + lengthHandle(h));
+  freeListHandle(h);
+
+  int* arr = malloc(nodes * sizeof(int));
+  for (int i = 0; i < nodes; i++) {
+    arr[i] = i;
+  }
+  t = now();
+  h = listFromArray(arr, nodes);
+  printf("%-36s %8d nodes %8.2f ns/node   (checksum %ld)\n", "listFromArray", nodes, (now() - t) * 1e9 / nodes,
+         sumList(h->head) + lengthHandle(h));
+  free(arr);
+
+  li = detachList(h);
+  t = now();
+  long checksum = itemAtPos(li, nodes - 1);
+  li = addItemAtPos(li, -1, nodes);
+  checksum += itemAtPos(li, nodes);
+  li = removeItem(li, -1);
+  printf("%-36s %8d nodes %8.2f ns/node   (checksum %ld)\n", "itemAtPos/addItemAtPos/removeItem", nodes,
+         (now() - t) * 1e9 / (4.0 * nodes), checksum);
+  freeList(li);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || (strcmp(argv[1], "pool") != 0 && strcmp(argv[1], "malloc") != 0 && strcmp(argv[1], "append") != 0)) {
+    fprintf(stderr, "usage: %s pool|malloc|append [NODES]\n", argv[0]);
+    return 1;
+  }
+  usePool = strcmp(argv[1], "pool") == 0;
+  long nodes = argc > 2 ? atol(argv[2]) : 10000000;
+  if (strcmp(argv[1], "append") == 0) {
+    benchAppend((int)nodes);
+    return 0;
+  }
+
+  bench("one list", nodes, 1);
+  bench("adjacency, 8 per list", nodes, nodes / 8);
+
+  // a pool, with removeFirstNode handing nodes back one by one
+  ListPool* pool = usePool ? newListPool() : NULL;
+  useListPool(pool);
+  double t0 = now();
+  List li = newEmptyList();
+  for (long i = 0; i < nodes; i++) {
+    li = usePool ? addItem((int)i, li) : mallocAddItem((int)i, li);
+  }
+  long checksum = sumList(li);
+  while (li != NULL) {
+    if (usePool) {
+      li = removeFirstNode(li);
+    } else {
+      List next = li->next;
+      free(li);
+      li = next;
+    }
+  }
+  printf("%-6s %-22s %6.2f ns/node                            (checksum %ld)\n", usePool ? "pool" : "malloc",
+         "removeFirstNode", (now() - t0) * 1e9 / nodes, checksum);
+  printf("%-6s peak RSS %ld MiB\n", usePool ? "pool" : "malloc", peakRssMiB());
+  if (pool != NULL) {
+    freeListPool(pool);
+  }
+  return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file  benchreduce.c
+ * @brief Throughput of the LibReduce kernels in GB/s, against scalar
+ * loops like those of maxarray.c and listsum.c, on an array of 10^9 ints
+ * and a list of 10^8 nodes. The Makefile builds it once per -march
+ * variant, so the SSE2 and AVX2 kernels are both measured.
+ *
+ * "verify" compares every kernel with a scalar loop on many lengths,
+ * including items near INT_MIN and INT_MAX.
+ *
+ * usage: benchreduce verify | benchreduce [ARRAY_ITEMS [LIST_NODES [THREADS]]]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LibList.h"
+#include "LibReduce.h"
+#include "LibTree.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+Reduction scalarReduction(const int* arr, size_t n) {
+  Reduction r = {0, INT_MAX, INT_MIN, 0, n};
+  for (size_t i = 0; i < n; i++) {
+    r.sum += arr[i];
+    r.min = arr[i] < r.min ? arr[i] : r.min;
+    if (arr[i] > r.max) {
+      r.max = arr[i];
+      r.argmax = i;
+    }
+  }
+  return r;
+}
+
+int same(Reduction a, Reduction b) {
+  return a.sum == b.sum && a.min == b.min && a.max == b.max && a.argmax == b.argmax && a.count == b.count;
+}
+
+void check(int ok, const char* what, size_t n) {
+  if (!ok) {
+    fprintf(stderr, "%s differs from the scalar loop for %zu items\n", what, n);
+    exit(1);
+  }
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  size_t maxN = 100000;
+  int* arr = malloc(maxN * sizeof(int));
+  for (size_t n = 0; n <= maxN; n = n < 70 ? n + 1 : n * 3 + 1) {
+    for (int kind = 0; kind < 3; kind++) {
+      for (size_t i = 0; i < n; i++) {
+        uint64_t r = xorshift(&x);
+        // full range, near the extremes, or few distinct values (ties)
+        arr[i] = kind == 0 ? (int)r : kind == 1 ? (r % 2 ? INT_MAX - (int)(r % 3) : INT_MIN + (int)(r % 3)) : (int)(r % 5);
+      }
+      Reduction expected = scalarReduction(arr, n);
+      check(sumArray(arr, n) == expected.sum, "sumArray", n);
+      check(n == 0 || minOfArray(arr, n) == expected.min, "minOfArray", n);
+      check(n == 0 || maxOfArray(arr, n) == expected.max, "maxOfArray", n);
+      check(argmaxOfArray(arr, n) == expected.argmax, "argmaxOfArray", n);
+      check(same(reduceArray(arr, n), expected), "reduceArray", n);
+      for (int threads = 1; threads <= 5; threads++) {
+        check(same(reduceArrayParallel(arr, n, threads), expected), "reduceArrayParallel", n);
+      }
+      ListHandle h = listFromArray(arr, (int)n);
+      check(same(reduceList(h->head), expected), "reduceList", n);
+      freeListHandle(h);
+      // a tree that is a path to the right has its items in pre-order
+      Tree t = emptyTree();
+      for (size_t i = n; i > 0 && n <= 10000; i--) {
+        t = newTree(arr[i - 1], emptyTree(), t);
+      }
+      check(n > 10000 || same(reduceTree(t), expected), "reduceTree", n);
+      freeTree(t);
+    }
+  }
+  free(arr);
+  printf("all reductions match the scalar loops\n");
+  return 0;
+}
+
+void report(const char* what, size_t bytes, double seconds, long long result) {
+  printf("%-44s %7.2f GB/s   (%lld)\n", what, bytes / seconds * 1e-9, result);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000000;
+  long nodes = argc > 2 ? atol(argv[2]) : 100000000;
+  int threads = argc > 3 ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+  uint64_t x = 88172645463325252u;
+  int* arr = malloc(n * sizeof(int));
+  assert(arr != NULL);
+  for (size_t i = 0; i < n; i++) {
+    arr[i] = (int)xorshift(&x);
+  }
+  size_t bytes = n * sizeof(int);
+  printf("%zu ints (%.1f GB), %d threads\n", n, bytes * 1e-9, threads);
+  double t;
+
+  t = now();
+  size_t best = 0;  // maxArray in maxarray.c before
+  for (size_t i = 0; i < n; i++) {
+    if (arr[i] >= arr[best]) {
+      best = i;
+    }
+  }
+  report("scalar max loop of maxarray.c", bytes, now() - t, arr[best]);
+  t = now();
+  long long sum = 0;
+  for (size_t i = 0; i < n; i++) {
+    sum += arr[i];
+  }
+  report("scalar sum loop (as compiled with -O3)", bytes, now() - t, sum);
+  t = now();
+  sum = sumArray(arr, n);
+  report("sumArray", bytes, now() - t, sum);
+  t = now();
+  sum = maxOfArray(arr, n);
+  report("maxOfArray", bytes, now() - t, sum);
+  t = now();
+  sum = (long long)argmaxOfArray(arr, n);
+  report("argmaxOfArray", bytes, now() - t, sum);
+  t = now();
+  sum = reduceArray(arr, n).sum;
+  report("reduceArray (sum, min, max, argmax)", bytes, now() - t, sum);
+  t = now();
+  sum = reduceArrayParallel(arr, n, threads).sum;
+  report("reduceArrayParallel", bytes, now() - t, sum);
+  free(arr);
+
+  // list bandwidth counts whole 16-byte nodes
+  ListHandle h = newListHandle();
+  for (long i = 0; i < nodes; i++) {
+    appendItem((int)xorshift(&x), h);
+  }
+  bytes = nodes * sizeof(struct ListNode);
+  printf("%ld list nodes (%.1f GB)\n", nodes, bytes * 1e-9);
+  t = now();
+  int intSum = 0;  // listSumIteration in listsum.c before
+  for (List p = h->head; p != NULL; p = p->next) {
+    intSum = (int)((unsigned int)intSum + (unsigned int)p->item);
+  }
+  report("scalar int sum of listsum.c (overflows)", bytes, now() - t, intSum);
+  t = now();
+  sum = reduceList(h->head).sum;
+  report("reduceList", bytes, now() - t, sum);
+  freeListHandle(h);
+  return 0;
+}
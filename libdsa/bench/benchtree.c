@@ -0,0 +1,226 @@
+/**
+ * @file  benchtree.c
+ * @brief Insertion and search time and tree height of a plain search
+ * tree (plainAddItem, without rebalancing) against the AVL tree of
+ * addInSearchTree, for keys in sorted and in random order, and removal
+ * with removeInSearchTree.
+ *
+ * On sorted keys the plain tree is a list and insertion is quadratic, so
+ * that case only runs with the first 20000 keys.
+ *
+ * "verify" checks the AVL property, the order and the contents of the
+ * balanced tree after every step of random inserts and removals, and that
+ * a tree built without rebalancing stays ordered under them.
+ *
+ * usage: benchtree verify | benchtree [KEYS]   (default 10^7)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LibTree.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+/*
+ * @brief Inserts n like addInSearchTree did before it balanced, leaving
+ * the heights of the nodes on the way stale
+ */
+Tree plainAddItem(Tree t, int n) {
+  Tree* link = &t;
+  while (*link != NULL && n != (*link)->item) {
+    link = (n < (*link)->item ? &(*link)->leftChild : &(*link)->rightChild);
+  }
+  if (*link == NULL) {
+    *link = newTree(n, emptyTree(), emptyTree());
+  }
+  return t;
+}
+
+/*
+ * @brief Height of t, counted without trusting the height fields
+ */
+int countHeight(Tree t) {
+  if (t == NULL) {
+    return 0;
+  }
+  int hL = countHeight(t->leftChild);
+  int hR = countHeight(t->rightChild);
+  return 1 + (hL > hR ? hL : hR);
+}
+
+/*
+ * @brief Checks the order of the keys in (low, high)
+ * @return The number of nodes, or -1 if something is wrong
+ */
+long checkOrder(Tree t, long low, long high) {
+  if (t == NULL) {
+    return 0;
+  }
+  if (t->item <= low || t->item >= high) {
+    return -1;
+  }
+  long nL = checkOrder(t->leftChild, low, t->item);
+  long nR = checkOrder(t->rightChild, t->item, high);
+  return nL < 0 || nR < 0 ? -1 : nL + nR + 1;
+}
+
+/*
+ * @brief Checks heights, balance and order of the keys in (low, high)
+ * @return The number of nodes, or -1 if something is wrong
+ */
+long checkAvl(Tree t, long low, long high) {
+  if (t == NULL) {
+    return 0;
+  }
+  int hL = heightTree(t->leftChild);
+  int hR = heightTree(t->rightChild);
+  if (t->item <= low || t->item >= high || t->height != 1 + (hL > hR ? hL : hR) || hL - hR > 1 || hR - hL > 1) {
+    return -1;
+  }
+  long nL = checkAvl(t->leftChild, low, t->item);
+  long nR = checkAvl(t->rightChild, t->item, high);
+  return nL < 0 || nR < 0 ? -1 : nL + nR + 1;
+}
+
+int verify(void) {
+  enum { RANGE = 2000, STEPS = 200000 };
+  char present[RANGE] = {0};
+  long size = 0;
+  uint64_t x = 88172645463325252u;
+  Tree t = emptyTree();
+  for (int step = 0; step < STEPS; step++) {
+    int n = (int)(xorshift(&x) % RANGE);
+    // insert more often at first, then remove more often
+    if (xorshift(&x) % STEPS < (uint64_t)(STEPS - step)) {
+      t = addInSearchTree(t, n);
+      size += !present[n];
+      present[n] = 1;
+    } else {
+      t = removeInSearchTree(t, n);
+      size -= present[n];
+      present[n] = 0;
+    }
+    int m = (int)(xorshift(&x) % RANGE);
+    if (checkAvl(t, -1, RANGE) != size || (searchNode(t, m) != NULL) != present[m]) {
+      printf("balanced tree wrong after step %d\n", step);
+      return 1;
+    }
+  }
+  freeTree(t);
+
+  // sorted and reverse sorted input, then removing every other key
+  for (int dir = 0; dir < 2; dir++) {
+    t = emptyTree();
+    for (int i = 0; i < 100000; i++) {
+      t = addInSearchTree(t, dir == 0 ? i : 99999 - i);
+    }
+    for (int i = 0; i < 100000; i += 2) {
+      t = removeInSearchTree(t, i);
+    }
+    if (checkAvl(t, -1, 100000) != 50000 || countHeight(t) > 20) {
+      printf("balanced tree wrong on sorted input\n");
+      return 1;
+    }
+    freeTree(t);
+  }
+
+  // a chain of 1000 keys with stale heights, deeper than any AVL path,
+  // then balanced operations on it
+  t = emptyTree();
+  for (int i = 0; i < 1000; i++) {
+    t = plainAddItem(t, i);
+  }
+  for (int i = 0; i < 2000; i += 3) {
+    t = i % 2 == 0 ? removeInSearchTree(t, i) : addInSearchTree(t, i);
+  }
+  size = 0;
+  for (int i = 0; i < 2000; i++) {
+    int in = i < 1000 ? i % 6 != 0 : i % 6 == 3;
+    size += in;
+    if ((searchNode(t, i) != NULL) != in) {
+      printf("unbalanced tree wrong at %d\n", i);
+      return 1;
+    }
+  }
+  if (checkOrder(t, -1, 2000) != size) {
+    printf("unbalanced tree out of order\n");
+    return 1;
+  }
+  freeTree(t);
+  printf("balanced tree matches the reference\n");
+  return 0;
+}
+
+/*
+ * @brief Inserts the keys, searches each of them, removes them (AVL
+ * only) in the same order, and prints the time per key of each step
+ */
+void bench(const char* order, const int* keys, long n, int balanced) {
+  double t0 = now();
+  Tree t = emptyTree();
+  for (long i = 0; i < n; i++) {
+    t = balanced ? addInSearchTree(t, keys[i]) : plainAddItem(t, keys[i]);
+  }
+  double t1 = now();
+  long found = 0;
+  for (long i = 0; i < n; i++) {
+    found += searchNode(t, keys[i]) != NULL;
+  }
+  double t2 = now();
+  int height = balanced ? heightTree(t) : countHeight(t);
+  printf("%-6s %-8s %9ld keys  insert %8.1f  search %8.1f ns/key", order, balanced ? "AVL" : "plain", n,
+         (t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n);
+  if (balanced) {
+    double t3 = now();
+    for (long i = 0; i < n; i++) {
+      t = removeInSearchTree(t, keys[i]);
+    }
+    printf("  remove %8.1f ns/key", (now() - t3) * 1e9 / n);
+  }
+  printf("   height %8d (found %ld)\n", height, found);
+  freeTree(t);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  long n = argc > 1 ? atol(argv[1]) : 10000000;
+  int* keys = malloc(n * sizeof(int));
+  for (long i = 0; i < n; i++) {
+    keys[i] = (int)i;
+  }
+  long small = n < 20000 ? n : 20000;
+  bench("sorted", keys, small, 0);
+  bench("sorted", keys, n, 1);
+
+  // the distinct keys 0 .. n-1 shuffled
+  uint64_t x = 88172645463325252u;
+  for (long i = n - 1; i > 0; i--) {
+    long j = (long)(xorshift(&x) % (uint64_t)(i + 1));
+    int tmp = keys[i];
+    keys[i] = keys[j];
+    keys[j] = tmp;
+  }
+  bench("random", keys, n, 0);
+  bench("random", keys, n, 1);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,63 @@
+### Shared part of the Makefiles of the DSA exercises that link libdsa.
+#
+# An exercise Makefile sets NAME and DSA (the path to this directory), and
+# optionally STD, EXTRA_FLAGS, KIND and CLEAN, then includes this file
+# before any rule of its own, so that "default" stays the first target.
+# Rules for benchmarks and extra tests follow the include.
+
+DSA_MARCH = native
+DSA_LIB = $(DSA)/build/$(DSA_MARCH)/libdsa.a
+
+STD ?= c99
+KIND ?= exercise
+
+GCC = gcc -g -O2 -std=$(STD) -pedantic -Wall -Wno-unused-result -flto -march=$(DSA_MARCH) -I$(DSA) $(EXTRA_FLAGS) -lm
+
+DIFF = diff -w
+
+VALGRIND = valgrind -s --leak-check=full --show-leak-kinds=all --errors-for-leak-kinds=all --error-exitcode=111
+
+.PHONY: default run-% test-% debug-% clean
+
+default:
+	@echo "Welcome to the DSA $(KIND) \"$(NAME)\"!\n"
+	@echo "Please edit the $(NAME).c file to answer the question."
+	@echo "Then use 'make run' to run and manually test your program."
+	@echo "If it seems good, use 'make test' to run automated tests."
+	@echo "To debug any memory problems, use 'make debug'."
+
+run: $(NAME)
+	./$(NAME)
+
+TESTS := $(wildcard tests/*.input.txt)
+
+.PHONY: run test $(TESTS)
+
+test: $(TESTS)
+
+$(TESTS): tests/%.input.txt: $(NAME)
+	@echo -n "\nRunning test "
+	@echo $*
+	@(./$(NAME) < tests/$*.input.txt | $(DIFF) - tests/$*.output.txt && echo "\e[1;32mPASSED :-)\e[0m" ) || make --no-print-directory fail
+
+debug: $(NAME)
+	$(VALGRIND) ./$(NAME)
+
+debug-test-1: $(NAME)
+	cat tests/1.input.txt | $(VALGRIND) ./$(NAME)
+
+fail:
+	@echo "\e[1;31mFAILED :-( \e[0m"
+	@echo "Please read the difference above carefully."
+	@echo "< is what your program outputs"
+	@echo "> is what the output should have been"
+	@false
+
+$(NAME): $(NAME).c $(DSA_LIB)
+	$(GCC) $^ -o $@
+
+$(DSA_LIB): $(wildcard $(DSA)/*.c $(DSA)/*.h)
+	$(MAKE) --no-print-directory -C $(DSA) MARCH=$(DSA_MARCH)
+
+clean:
+	rm -f *.out *.a $(CLEAN)
@@ -0,0 +1,180 @@
+/**
+ * @file  benchsort.c
+ * @brief The previous insertion sort of listsort.c against sortList and
+ * sortListRadix, on random, sorted, reversed and nearly sorted lists.
+ *
+ * "verify" checks on smaller lists that both sorts order the items and
+ * keep nodes with equal items in their original order. The insertion
+ * sort only runs up to 10^4 nodes, where it already takes about as long
+ * as the others at 10^7.
+ *
+ * usage: benchsort verify | benchsort [MAXNODES]   (default 10^7)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LibList.h"
+
+#define INSERTION_MAX 10000
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+// the sort of listsort.c before sortList
+List insertionSort(List li) {
+  List sorted = newEmptyList();
+  List current = li;
+  while (current != NULL) {
+    List next = current->next;
+    if (sorted == NULL || current->item < sorted->item) {
+      current->next = sorted;
+      sorted = current;
+    } else {
+      List p = sorted;
+      while (p->next != NULL && p->next->item <= current->item) {
+        p = p->next;
+      }
+      current->next = p->next;
+      p->next = current;
+    }
+    current = next;
+  }
+  return sorted;
+}
+
+const char* orders[] = {"random", "sorted", "reversed", "nearly sorted"};
+
+/*
+ * @brief Fills arr with n items in the given order; range limits the
+ * random items, to get many equal ones
+ */
+void fill(int* arr, int n, int order, int range, uint64_t* x) {
+  for (int i = 0; i < n; i++) {
+    arr[i] = order == 0 ? (int)(xorshift(x) % range) - range / 2 : order == 2 ? n - i : i;
+  }
+  if (order == 3) {
+    // swap 1% of the items with a neighbour up to 8 places away
+    for (int s = 0; s < n / 100; s++) {
+      int i = (int)(xorshift(x) % n);
+      int j = i + (int)(xorshift(x) % 8);
+      if (j < n) {
+        int t = arr[i];
+        arr[i] = arr[j];
+        arr[j] = t;
+      }
+    }
+  }
+}
+
+typedef struct Position {
+  List node;
+  int index;
+} Position;
+
+int comparePositions(const void* a, const void* b) {
+  List p = ((const Position*)a)->node;
+  List q = ((const Position*)b)->node;
+  return (p > q) - (p < q);
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  int sizes[] = {0, 1, 2, 3, 17, 1000, 100000};
+  List (*sorts[])(List) = {sortList, sortListRadix, insertionSort};
+  const char* names[] = {"sortList", "sortListRadix", "insertionSort"};
+  for (int s = 0; s < 3; s++) {
+    for (int z = 0; z < 7; z++) {
+      int n = sizes[z];
+      if (s == 2 && n > INSERTION_MAX) {
+        continue;
+      }
+      for (int order = 0; order < 4; order++) {
+        int* arr = malloc((n + 1) * sizeof(int));
+        fill(arr, n, order, 50, &x);
+        ListHandle h = listFromArray(arr, n);
+        Position* positions = malloc((n + 1) * sizeof(Position));
+        int i = 0;
+        for (List p = h->head; p != NULL; p = p->next, i++) {
+          positions[i].node = p;
+          positions[i].index = i;
+        }
+        qsort(positions, n, sizeof(Position), comparePositions);
+        List li = sorts[s](detachList(h));
+        int count = 0;
+        int previousIndex = -1;
+        for (List p = li; p != NULL; p = p->next, count++) {
+          Position key = {p, 0};
+          Position* found = bsearch(&key, positions, n, sizeof(Position), comparePositions);
+          if (found == NULL || (p->next != NULL && p->next->item < p->item)) {
+            fprintf(stderr, "%s: not sorted (%s, %d nodes)\n", names[s], orders[order], n);
+            return 1;
+          }
+          // equal neighbours must keep their original order
+          if (previousIndex >= 0 && found->index < previousIndex) {
+            fprintf(stderr, "%s: not stable (%s, %d nodes)\n", names[s], orders[order], n);
+            return 1;
+          }
+          previousIndex = (p->next != NULL && p->next->item == p->item) ? found->index : -1;
+        }
+        if (count != n) {
+          fprintf(stderr, "%s: lost nodes (%s, %d nodes)\n", names[s], orders[order], n);
+          return 1;
+        }
+        freeList(li);
+        free(positions);
+        free(arr);
+      }
+    }
+  }
+  printf("all sorts are sorted and stable\n");
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  int maxNodes = argc > 1 ? atoi(argv[1]) : 10000000;
+  List (*sorts[])(List) = {insertionSort, sortList, sortListRadix};
+  const char* names[] = {"insertion sort", "sortList", "sortListRadix"};
+  int* arr = malloc(maxNodes * sizeof(int));
+  printf("%-14s %-14s %10s %12s\n", "sort", "input", "nodes", "ns/node");
+  for (int order = 0; order < 4; order++) {
+    for (int n = 1000; n <= maxNodes; n *= 10) {
+      uint64_t x = 88172645463325252u;
+      fill(arr, n, order, 1 << 30, &x);
+      for (int s = 0; s < 3; s++) {
+        if (s == 0 && n > INSERTION_MAX) {
+          continue;
+        }
+        // a new pool each time, so every sort starts from nodes in order
+        ListPool* pool = newListPool();
+        useListPool(pool);
+        ListHandle h = listFromArray(arr, n);
+        double t = now();
+        List li = sorts[s](detachList(h));
+        t = now() - t;
+        printf("%-14s %-14s %10d %12.2f   (first %d)\n", names[s], orders[order], n, t * 1e9 / n, li->item);
+        freeListPool(pool);
+      }
+    }
+  }
+  free(arr);
+  return 0;
+}
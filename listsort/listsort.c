@@ -1,33 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include "libs/LibList.h"
+#include "LibList.h"
 
 // Write a function that sorts a list.
 
+// sortList in LibList is a stable natural merge sort: it merges the
+// runs that are already in the list, in O(n log n) and by relinking the
+// nodes. The insertion sort this replaces is in bench/benchsort.c.
 List sort(List li) {
-	if (isEmptyList(li) || li->next == NULL) {
-        return li; 
-    }
-
-    List sorted = newEmptyList();  
-    List current = li;   
-
-    while (current != NULL) {
-        List next = current->next;  // store the next node
-        if (sorted == NULL || current->item < sorted->item) {
-            current->next = sorted;
-            sorted = current;
-        } else {
-            List p = sorted;
-            while (p->next != NULL && p->next->item <= current->item)
-                p = p->next;
-            current->next = p->next;
-            p->next = current;
-        }
-        current = next;
-    }
-
-    return sorted;
+  return sortList(li);
 }
 
 
@@ -0,0 +1,267 @@
+/**
+ * @file  benchstore.c
+ * @brief Adjacency lists of a random directed graph as one List per
+ * vertex against one ListStore: building, a sweep over all lists, a
+ * breadth-first search, and peak RSS. "convert" times listToStore and
+ * writing the store to a file. Run each in its own process.
+ *
+ * usage: benchstore verify | benchstore list|store|convert [VERTICES EDGES]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "LibList.h"
+#include "LibListStore.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long peakRssMiB(void) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+void check(int ok, const char* what) {
+  if (!ok) {
+    fprintf(stderr, "mismatch in %s\n", what);
+    exit(1);
+  }
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  ListStore st = newListStore(0);
+  List lists[100];
+  ListIndex heads[100];
+  for (int v = 0; v < 100; v++) {
+    lists[v] = newEmptyList();
+    for (int i = (int)(xorshift(&x) % 50); i > 0; i--) {
+      lists[v] = addItem((int)(xorshift(&x) % 1000), lists[v]);
+    }
+    heads[v] = listToStore(lists[v], st);
+  }
+  // drop and rebuild some lists, so nodes go round the free list
+  for (int round = 0; round < 1000; round++) {
+    int v = (int)(xorshift(&x) % 100);
+    if (xorshift(&x) % 2 == 0 && heads[v] != NIL_INDEX) {
+      heads[v] = removeFirstStore(heads[v], st);
+      lists[v] = removeFirstNode(lists[v]);
+    } else {
+      freeListInStore(heads[v], st);
+      heads[v] = listToStore(lists[v], st);
+    }
+  }
+  FILE* f = tmpfile();
+  check(writeListStore(st, f), "writeListStore");
+  rewind(f);
+  ListStore copy = readListStore(f);
+  check(copy != NULL, "readListStore");
+
+  // a link past the last node and a cut short file are refused; the
+  // header is 8 bytes of magic, then size and freeNodes
+  uint32_t size = sizeListStore(st);
+  uint32_t freeNodes;
+  fseek(f, 12, SEEK_SET);
+  check(fread(&freeNodes, sizeof(uint32_t), 1, f) == 1, "reading freeNodes");
+  fseek(f, 12, SEEK_SET);
+  fwrite(&size, sizeof(uint32_t), 1, f);
+  rewind(f);
+  check(readListStore(f) == NULL, "readListStore with freeNodes past the end");
+  fseek(f, 12, SEEK_SET);
+  fwrite(&freeNodes, sizeof(uint32_t), 1, f);
+  fseek(f, 16 + (long)(size - 1) * sizeof(StoreNode) + offsetof(StoreNode, next), SEEK_SET);
+  fwrite(&size, sizeof(uint32_t), 1, f);
+  rewind(f);
+  check(readListStore(f) == NULL, "readListStore with a next past the end");
+  fclose(f);
+  f = tmpfile();
+  check(writeListStore(st, f), "writeListStore");
+  fflush(f);
+  FILE* cut = tmpfile();
+  rewind(f);
+  for (long i = 0; i < 16 + (long)(size - 1) * (long)sizeof(StoreNode); i++) {
+    fputc(fgetc(f), cut);
+  }
+  rewind(cut);
+  check(readListStore(cut) == NULL, "readListStore of a cut short file");
+  fclose(cut);
+  fclose(f);
+  for (int v = 0; v < 100; v++) {
+    List back = storeToList(heads[v], copy);
+    List p = lists[v];
+    List q = back;
+    for (; p != NULL && q != NULL; p = p->next, q = q->next) {
+      check(p->item == q->item, "items");
+    }
+    check(p == NULL && q == NULL, "lengths");
+    check(lengthInStore(heads[v], st) == lengthInStore(heads[v], copy), "lengthInStore");
+    freeList(back);
+    freeList(lists[v]);
+  }
+  freeListStore(st);
+  freeListStore(copy);
+  printf("list store matches the lists, also after writing and reading\n");
+  return 0;
+}
+
+/*
+ * @brief Breadth-first search from vertex 0; returns a checksum of the
+ * order in which the vertices are found
+ */
+long bfsList(List* adjacency, int vertices) {
+  char* seen = calloc(vertices, 1);
+  int* queue = malloc(vertices * sizeof(int));
+  int begin = 0;
+  int end = 0;
+  long checksum = 0;
+  queue[end++] = 0;
+  seen[0] = 1;
+  while (begin < end) {
+    int u = queue[begin++];
+    checksum = checksum * 31 + u;
+    for (List p = adjacency[u]; p != NULL; p = p->next) {
+      if (!seen[p->item]) {
+        seen[p->item] = 1;
+        queue[end++] = p->item;
+      }
+    }
+  }
+  free(seen);
+  free(queue);
+  return checksum;
+}
+
+long bfsStore(ListIndex* heads, const StoreNode* nodes, int vertices) {
+  char* seen = calloc(vertices, 1);
+  int* queue = malloc(vertices * sizeof(int));
+  int begin = 0;
+  int end = 0;
+  long checksum = 0;
+  queue[end++] = 0;
+  seen[0] = 1;
+  while (begin < end) {
+    int u = queue[begin++];
+    checksum = checksum * 31 + u;
+    for (ListIndex p = heads[u]; p != NIL_INDEX; p = nodes[p].next) {
+      if (!seen[nodes[p].item]) {
+        seen[nodes[p].item] = 1;
+        queue[end++] = nodes[p].item;
+      }
+    }
+  }
+  free(seen);
+  free(queue);
+  return checksum;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  if (argc < 2 || (strcmp(argv[1], "list") != 0 && strcmp(argv[1], "store") != 0 && strcmp(argv[1], "convert") != 0)) {
+    fprintf(stderr, "usage: %s verify | %s list|store|convert [VERTICES EDGES]\n", argv[0], argv[0]);
+    return 1;
+  }
+  int vertices = argc > 3 ? atoi(argv[2]) : 1000000;
+  long edges = argc > 3 ? atol(argv[3]) : 16000000;
+  const char* mode = argv[1];
+  uint64_t x = 88172645463325252u;
+  double t;
+  long sum = 0;
+
+  if (strcmp(mode, "store") == 0) {
+    t = now();
+    ListStore st = newListStore(0);
+    ListIndex* heads = malloc(vertices * sizeof(ListIndex));
+    for (int v = 0; v < vertices; v++) {
+      heads[v] = NIL_INDEX;
+    }
+    for (long i = 0; i < edges; i++) {
+      int from = (int)(xorshift(&x) % vertices);
+      heads[from] = addItemStore((int)(xorshift(&x) % vertices), heads[from], st);
+    }
+    printf("store  build %6.2f ns/edge\n", (now() - t) * 1e9 / edges);
+    const StoreNode* nodes = nodesListStore(st);
+    t = now();
+    for (int v = 0; v < vertices; v++) {
+      for (ListIndex p = heads[v]; p != NIL_INDEX; p = nodes[p].next) {
+        sum += nodes[p].item;
+      }
+    }
+    printf("store  sweep %6.2f ns/edge   (checksum %ld)\n", (now() - t) * 1e9 / edges, sum);
+    t = now();
+    sum = bfsStore(heads, nodes, vertices);
+    printf("store  BFS   %6.2f ns/edge   (checksum %ld)\n", (now() - t) * 1e9 / edges, sum);
+    freeListStore(st);
+    free(heads);
+  } else {
+    t = now();
+    List* adjacency = malloc(vertices * sizeof(List));
+    for (int v = 0; v < vertices; v++) {
+      adjacency[v] = newEmptyList();
+    }
+    for (long i = 0; i < edges; i++) {
+      int from = (int)(xorshift(&x) % vertices);
+      adjacency[from] = addItem((int)(xorshift(&x) % vertices), adjacency[from]);
+    }
+    double build = (now() - t) * 1e9 / edges;
+    if (strcmp(mode, "list") == 0) {
+      printf("list   build %6.2f ns/edge\n", build);
+      t = now();
+      for (int v = 0; v < vertices; v++) {
+        for (List p = adjacency[v]; p != NULL; p = p->next) {
+          sum += p->item;
+        }
+      }
+      printf("list   sweep %6.2f ns/edge   (checksum %ld)\n", (now() - t) * 1e9 / edges, sum);
+      t = now();
+      sum = bfsList(adjacency, vertices);
+      printf("list   BFS   %6.2f ns/edge   (checksum %ld)\n", (now() - t) * 1e9 / edges, sum);
+    } else {
+      // converted vertex by vertex, so each list ends up contiguous
+      t = now();
+      ListStore st = newListStore(edges);
+      ListIndex* heads = malloc(vertices * sizeof(ListIndex));
+      for (int v = 0; v < vertices; v++) {
+        heads[v] = listToStore(adjacency[v], st);
+      }
+      printf("listToStore %6.2f ns/edge\n", (now() - t) * 1e9 / edges);
+      t = now();
+      sum = bfsStore(heads, nodesListStore(st), vertices);
+      printf("converted store BFS %6.2f ns/edge   (checksum %ld)\n", (now() - t) * 1e9 / edges, sum);
+      FILE* f = tmpfile();
+      t = now();
+      writeListStore(st, f);
+      fflush(f);
+      printf("writeListStore %6.2f ns/edge (%.0f MiB)\n", (now() - t) * 1e9 / edges, sizeListStore(st) * 8.0 / (1 << 20));
+      fclose(f);
+      freeListStore(st);
+      free(heads);
+    }
+    for (int v = 0; v < vertices; v++) {
+      freeList(adjacency[v]);
+    }
+    free(adjacency);
+  }
+  printf("%-6s peak RSS %ld MiB\n", mode, peakRssMiB());
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibListStore.h"
+
+// Read a directed graph and keep its adjacency lists in a ListStore: one
+// ListIndex per vertex, all nodes in one array. To show that the store
+// needs no pointer fixing, it is written to a temporary file together
+// with the heads, read back, and the copy is printed.
+
+int main(void) {
+  int n = 0;
+  int e = 0;
+  printf("How many vertices?\n");
+  scanf("%d", &n);
+  printf("How many edges?\n");
+  scanf("%d", &e);
+  ListStore st = newListStore(e);
+  ListIndex* heads = malloc(n * sizeof(ListIndex));
+  for (int x = 0; x < n; x++) {
+    heads[x] = NIL_INDEX;
+  }
+  printf("Please enter the edges, one \"from to\" pair per line:\n");
+  for (int i = 0; i < e; i++) {
+    int from;
+    int to;
+    scanf("%d %d", &from, &to);
+    heads[from] = addItemStore(to, heads[from], st);
+  }
+
+  FILE* f = tmpfile();
+  writeListStore(st, f);
+  fwrite(heads, sizeof(ListIndex), n, f);
+  freeListStore(st);
+  rewind(f);
+  st = readListStore(f);
+  assert(st != NULL && fread(heads, sizeof(ListIndex), n, f) == (size_t)n);
+  fclose(f);
+
+  printf("After writing and reading back %u nodes:\n", sizeListStore(st));
+  for (int x = 0; x < n; x++) {
+    printf("reachable from %d:", x);
+    for (ListIndex li = heads[x]; li != NIL_INDEX; li = nextStore(li, st)) {
+      printf(" %d", itemStore(li, st));
+    }
+    printf("\n");
+  }
+  freeListStore(st);
+  free(heads);
+  exit(0);
+}
@@ -1,16 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "LibReduce.h"
+
 // Write a function that finds the maximum value in an array.
 
+// maxOfArray compares 8 (AVX2) or 4 (SSE2) numbers at a time.
 int maxArray(int arr[], int arrLength) {
-  int maxValueIndex = 0;
-  for (int i = 0; i<arrLength; i++){
-	  if (arr[i] >= arr[maxValueIndex]){
-		 maxValueIndex = i;
-	  }
-  }
-  return arr[maxValueIndex];
+  return maxOfArray(arr, arrLength);
 }
 
 // do not modify the main function
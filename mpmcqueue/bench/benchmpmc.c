@@ -0,0 +1,138 @@
+/**
+ * @file  benchmpmc.c
+ * @brief Scaling of QueueMPMC against LibQueue behind a mutex.
+ *
+ * For every thread count T in 1, 2, 4, 8, 16 the benchmark runs T/2
+ * producers and T/2 consumers (T = 1: one thread alternating enqueue and
+ * dequeue) that together move ITEMS integers through one queue.
+ *
+ * usage: benchmpmc [ITEMS] [CAPACITY]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LibQueue.h"
+#include "LibQueueMPMC.h"
+
+typedef struct Run {
+  int mpmc;  // 1: QueueMPMC, 0: LibQueue + mutex
+  QueueMPMC q;
+  Queue locked;
+  pthread_mutex_t lock;
+  long perThread;
+  atomic_long checksum;
+} Run;
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void put(Run* r, int item) {
+  if (r->mpmc) {
+    enqueueMPMC(item, r->q);
+    return;
+  }
+  pthread_mutex_lock(&r->lock);
+  enqueue(item, r->locked);
+  pthread_mutex_unlock(&r->lock);
+}
+
+int get(Run* r) {
+  if (r->mpmc) {
+    return dequeueMPMC(r->q);
+  }
+  for (;;) {
+    pthread_mutex_lock(&r->lock);
+    if (!isEmptyQueue(r->locked)) {
+      int item = dequeue(r->locked);
+      pthread_mutex_unlock(&r->lock);
+      return item;
+    }
+    pthread_mutex_unlock(&r->lock);
+    sched_yield();
+  }
+}
+
+void* produce(void* arg) {
+  Run* r = arg;
+  for (long i = 0; i < r->perThread; i++) {
+    put(r, (int)i);
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  Run* r = arg;
+  long sum = 0;
+  for (long i = 0; i < r->perThread; i++) {
+    sum += get(r);
+  }
+  atomic_fetch_add(&r->checksum, sum);
+  return NULL;
+}
+
+double run(int mpmc, int threads, long items, int capacity) {
+  Run r;
+  r.mpmc = mpmc;
+  r.q = newQueueMPMC(capacity);
+  r.locked = newQueueWithCapacity(capacity);
+  pthread_mutex_init(&r.lock, NULL);
+  atomic_init(&r.checksum, 0);
+
+  double start = now();
+  if (threads == 1) {
+    r.perThread = items;
+    long sum = 0;
+    for (long i = 0; i < items; i++) {
+      put(&r, (int)i);
+      sum += get(&r);
+    }
+    atomic_store(&r.checksum, sum);
+  } else {
+    int pairs = threads / 2;
+    pthread_t* t = malloc(threads * sizeof(pthread_t));
+    r.perThread = items / pairs;
+    for (int i = 0; i < pairs; i++) {
+      pthread_create(&t[2 * i], NULL, produce, &r);
+      pthread_create(&t[2 * i + 1], NULL, consume, &r);
+    }
+    for (int i = 0; i < threads; i++) {
+      pthread_join(t[i], NULL);
+    }
+    free(t);
+  }
+  double seconds = now() - start;
+
+  long pairs = threads == 1 ? 1 : threads / 2;
+  long expected = pairs * (r.perThread * (r.perThread - 1) / 2);
+  if (atomic_load(&r.checksum) != expected) {
+    printf("checksum mismatch!\n");
+  }
+  freeQueueMPMC(r.q);
+  freeQueue(r.locked);
+  pthread_mutex_destroy(&r.lock);
+  return seconds;
+}
+
+int main(int argc, char* argv[]) {
+  long items = argc > 1 ? atol(argv[1]) : 10000000;
+  int capacity = argc > 2 ? atoi(argv[2]) : 1024;
+
+  printf("%ld items, capacity %d\n", items, capacity);
+  printf("threads   MPMC Mitems/s   mutex+LibQueue Mitems/s\n");
+  for (int threads = 1; threads <= 16; threads *= 2) {
+    double a = run(1, threads, items, capacity);
+    double b = run(0, threads, items, capacity);
+    printf("%7d   %15.1f   %23.1f\n", threads, items / a * 1e-6, items / b * 1e-6);
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibQueueMPMC.h"
+
+// Stress test for the multi-producer/multi-consumer queue.
+// Producer p enqueues the items p * N, ..., p * N + N - 1. After all
+// producers are done, main enqueues one -1 per consumer to stop them.
+// We check that every item was dequeued exactly once, and that each
+// consumer saw the items of every single producer in increasing order.
+
+typedef struct Shared {
+  QueueMPMC q;
+  int producers;
+  int perProducer;
+  atomic_int* seen;  // how often each item was dequeued
+  atomic_bool inOrder;
+} Shared;
+
+typedef struct Worker {
+  Shared* shared;
+  int id;
+} Worker;
+
+void* produce(void* arg) {
+  Worker* w = arg;
+  int first = w->id * w->shared->perProducer;
+  for (int i = 0; i < w->shared->perProducer; i++) {
+    // mix blocking and non-blocking calls
+    if (i % 2 == 0) {
+      enqueueMPMC(first + i, w->shared->q);
+    } else {
+      while (!tryEnqueueMPMC(first + i, w->shared->q)) {
+        sched_yield();
+      }
+    }
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  Worker* w = arg;
+  Shared* s = w->shared;
+  int* last = malloc(s->producers * sizeof(int));  // last item seen per producer
+  for (int p = 0; p < s->producers; p++) {
+    last[p] = -1;
+  }
+  int item;
+  while ((item = dequeueMPMC(s->q)) != -1) {
+    int p = item / s->perProducer;
+    if (item <= last[p]) {
+      atomic_store(&s->inOrder, false);
+    }
+    last[p] = item;
+    atomic_fetch_add(&s->seen[item], 1);
+  }
+  free(last);
+  return NULL;
+}
+
+int main(void) {
+  int producers, consumers, perProducer, capacity;
+  printf("How many producers, consumers, items per producer and what queue capacity?\n");
+  if (scanf("%d %d %d %d", &producers, &consumers, &perProducer, &capacity) != 4) {
+    exit(1);
+  }
+
+  Shared s;
+  s.q = newQueueMPMC(capacity);
+  s.producers = producers;
+  s.perProducer = perProducer;
+  s.seen = calloc((size_t)producers * perProducer, sizeof(atomic_int));
+  atomic_init(&s.inOrder, true);
+
+  pthread_t* threads = malloc((producers + consumers) * sizeof(pthread_t));
+  Worker* workers = malloc((producers + consumers) * sizeof(Worker));
+  for (int t = 0; t < producers + consumers; t++) {
+    workers[t].shared = &s;
+    workers[t].id = t < producers ? t : t - producers;
+    pthread_create(&threads[t], NULL, t < producers ? produce : consume, &workers[t]);
+  }
+  for (int t = 0; t < producers; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  for (int t = 0; t < consumers; t++) {
+    enqueueMPMC(-1, s.q);
+  }
+  for (int t = producers; t < producers + consumers; t++) {
+    pthread_join(threads[t], NULL);
+  }
+
+  int missing = 0, duplicated = 0;
+  for (int i = 0; i < producers * perProducer; i++) {
+    int n = atomic_load(&s.seen[i]);
+    missing += (n == 0);
+    duplicated += (n > 1);
+  }
+  printf("%d producers and %d consumers passed %d items through a queue of capacity %d.\n", producers, consumers,
+         producers * perProducer, capacity);
+  if (missing == 0 && duplicated == 0) {
+    printf("Every item was received exactly once.\n");
+  } else {
+    printf("%d items were lost and %d were received more than once!\n", missing, duplicated);
+  }
+  if (atomic_load(&s.inOrder)) {
+    printf("Every consumer saw the items of each producer in order.\n");
+  } else {
+    printf("Some consumer saw the items of a producer out of order!\n");
+  }
+  printf("The queue is %s.\n", isEmptyQueueMPMC(s.q) ? "empty" : "not empty");
+
+  free(threads);
+  free(workers);
+  free(s.seen);
+  freeQueueMPMC(s.q);
+  exit(0);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file  benchmemory.c
+ * @brief Resident memory over time of LibQueue and LibStack under a bursty
+ * workload: a burst of BURST items, a drain down to a small working set,
+ * and a long quiet phase at that size, repeated.
+ *
+ * usage: benchmemory verify
+ *        benchmemory queue|stack shrink|pinned [BURST]   (default 4000000)
+ *
+ * "pinned" reserves the burst size up front, which is how both containers
+ * behaved before they could shrink. Run each variant in its own process.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LibQueue.h"
+#include "LibStack.h"
+
+#define CYCLES 4
+#define QUIET 1000       /* items live between bursts */
+#define QUIET_OPS 2000000
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* current (not peak) resident set size */
+long rssKb(void) {
+  long pages = 0, resident = 0;
+  FILE* f = fopen("/proc/self/statm", "r");
+  if (f != NULL) {
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) {
+      resident = 0;
+    }
+    fclose(f);
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/* a queue or a stack behind the same three calls */
+typedef struct Container {
+  int isQueue;
+  Queue q;
+  Stack st;
+} Container;
+
+void put(int item, Container* c) {
+  if (c->isQueue) {
+    enqueue(item, c->q);
+  } else {
+    push(item, c->st);
+  }
+}
+
+int take(Container* c) {
+  return c->isQueue ? dequeue(c->q) : pop(c->st);
+}
+
+int length(Container* c) {
+  return c->isQueue ? lengthQueue(c->q) : lengthStack(c->st);
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+/* random operations including reserve/shrink/clear, checked against an array */
+int verify(void) {
+  int cap = 1 << 20;
+  int* ref = malloc(cap * sizeof(int));
+  for (int isQueue = 0; isQueue < 2; isQueue++) {
+    Container c = {isQueue, newQueue(), newStack()};
+    int lo = 0, hi = 0;
+    uint64_t x = 2463534242u;
+    for (long i = 0; i < 20000000; i++) {
+      uint64_t r = xorshift(&x);
+      int growing = (i >> 16) & 1; /* alternate so the array grows and shrinks */
+      int op = r % 1000;
+      if (op < 450 + 100 * growing && hi < cap) {
+        put((int)(r >> 32), &c);
+        ref[hi++] = (int)(r >> 32);
+      } else if (op < 998 && lo < hi) {
+        int got = take(&c);
+        int want = isQueue ? ref[lo++] : ref[--hi];
+        if (got != want) {
+          printf("verify %s: step %ld: got %d, want %d\n", isQueue ? "queue" : "stack", i, got, want);
+          return 1;
+        }
+      } else if (op == 998) {
+        int capacity = (int)(r >> 40) % 5000;
+        isQueue ? reserveQueue(capacity, c.q) : reserveStack(capacity, c.st);
+      } else if (op == 999) {
+        isQueue ? shrinkQueueToFit(c.q) : shrinkStackToFit(c.st);
+      }
+      if ((r >> 20) % 100000 == 0) {
+        isQueue ? clearQueue(c.q) : clearStack(c.st);
+        lo = hi;
+      }
+      if (length(&c) != hi - lo) {
+        printf("verify %s: step %ld: length %d, want %d\n", isQueue ? "queue" : "stack", i, length(&c), hi - lo);
+        return 1;
+      }
+      if (lo == hi || hi == cap) {
+        /* restart the reference; drain whatever the container still holds */
+        while (lo < hi) {
+          take(&c);
+          lo++;
+        }
+        lo = hi = 0;
+      }
+    }
+    freeQueue(c.q);
+    freeStack(c.st);
+  }
+  free(ref);
+  printf("verify: ok\n");
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc == 2 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s verify | queue|stack shrink|pinned [BURST]\n", argv[0]);
+    return 2;
+  }
+  Container c = {strcmp(argv[1], "queue") == 0, NULL, NULL};
+  int pinned = strcmp(argv[2], "pinned") == 0;
+  int burst = argc > 3 ? atoi(argv[3]) : 4000000;
+  c.q = c.isQueue ? newQueue() : NULL;
+  c.st = c.isQueue ? NULL : newStack();
+  if (pinned) {
+    c.isQueue ? reserveQueue(burst + QUIET, c.q) : reserveStack(burst + QUIET, c.st);
+  }
+
+  printf("%s, %s, bursts of %d items (%ld MiB)\n", c.isQueue ? "LibQueue" : "LibStack", pinned ? "pinned at peak" : "shrinking", burst,
+         (long)burst * sizeof(int) >> 20);
+  printf("%5s %-6s %8s %10s\n", "cycle", "phase", "items", "RSS KiB");
+  long checksum = 0;
+  double start = now();
+  for (int cycle = 0; cycle < CYCLES; cycle++) {
+    for (int i = 0; i < burst; i++) {
+      put(i, &c);
+    }
+    printf("%5d %-6s %8d %10ld\n", cycle, "burst", length(&c), rssKb());
+    while (length(&c) > QUIET) {
+      checksum += take(&c);
+    }
+    printf("%5d %-6s %8d %10ld\n", cycle, "drain", length(&c), rssKb());
+    for (int i = 0; i < QUIET_OPS; i++) {
+      put(i, &c);
+      checksum += take(&c);
+    }
+    printf("%5d %-6s %8d %10ld\n", cycle, "quiet", length(&c), rssKb());
+  }
+  printf("%.2f s (checksum %ld)\n\n", now() - start, checksum);
+  if (c.isQueue) {
+    freeQueue(c.q);
+  } else {
+    freeStack(c.st);
+  }
+  return 0;
+}
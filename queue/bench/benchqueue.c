@@ -0,0 +1,280 @@
+/**
+ * @file  benchqueue.c
+ * @brief Compares the power-of-two ring LibQueue against the previous
+ * modulo-indexed queue (reproduced below as OldQueue), and the opaque
+ * LibQueue calls against the same ring inlined from DEFINE_QUEUE.
+ *
+ * usage: benchqueue [OPS]   (default 100000000)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LibQueue.h"
+#include "LibQueueTemplate.h"
+
+#define BULK 256
+
+/* the previous LibQueue: starts at 7 slots, "% size" per operation */
+typedef struct OldQueue {
+  int* array;
+  int back;
+  int front;
+  int size;
+} OldQueue;
+
+OldQueue* oldNewQueue(void) {
+  OldQueue* q = malloc(sizeof(OldQueue));
+  assert(q != NULL);
+  q->array = malloc(7 * sizeof(int));
+  assert(q->array != NULL);
+  q->back = 0;
+  q->front = 0;
+  q->size = 7;
+  return q;
+}
+
+void oldEnqueue(int item, OldQueue* q) {
+  q->array[q->back] = item;
+  q->back = (q->back + 1) % q->size;
+  if (q->back == q->front) {
+    int oldSize = q->size;
+    q->size = 2 * oldSize;
+    q->array = realloc(q->array, q->size * sizeof(int));
+    assert(q->array != NULL);
+    for (int i = 0; i < q->back; i++) {
+      q->array[oldSize + i] = q->array[i];
+    }
+    q->back = q->back + oldSize;
+  }
+}
+
+int oldDequeue(OldQueue* q) {
+  assert(q->back != q->front);
+  int item = q->array[q->front];
+  q->front = (q->front + 1) % q->size;
+  return item;
+}
+
+void oldFreeQueue(OldQueue* q) {
+  free(q->array);
+  free(q);
+}
+
+DEFINE_QUEUE(IntQueue, int)
+
+/* a typical struct payload, stored unboxed */
+typedef struct Event {
+  int id;
+  int kind;
+  double time;
+} Event;
+
+DEFINE_QUEUE(EventQueue, Event)
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void report(const char* name, long ops, double seconds, long checksum) {
+  printf("%-28s %8.2f ns/op %9.1f Mops/s   (checksum %ld)\n", name, seconds * 1e9 / ops, ops / seconds * 1e-6, checksum);
+}
+
+/* random mix of single and bulk operations, checked against OldQueue */
+void verify(void) {
+  OldQueue* ref = oldNewQueue();
+  Queue q = newQueueWithCapacity(3);
+  int items[BULK];
+  int count = 0;
+  srand(42);
+  for (int step = 0; step < 1000000; step++) {
+    int op = rand() % 4;
+    if (op == 0 || (op == 1 && count == 0)) {
+      enqueue(step, q);
+      oldEnqueue(step, ref);
+      count++;
+    } else if (op == 1) {
+      // dequeue outside assert, so that -DNDEBUG keeps the queues in step
+      int item = dequeue(q);
+      int expected = oldDequeue(ref);
+      assert(item == expected);
+      (void)item, (void)expected;  // unused under -DNDEBUG
+      count--;
+    } else if (op == 2) {
+      int n = rand() % BULK;
+      for (int i = 0; i < n; i++) {
+        items[i] = step + i;
+        oldEnqueue(step + i, ref);
+      }
+      enqueueMany(items, n, q);
+      count += n;
+    } else {
+      int n = dequeueMany(items, rand() % BULK, q);
+      for (int i = 0; i < n; i++) {
+        int expected = oldDequeue(ref);
+        assert(items[i] == expected);
+        (void)expected;
+      }
+      count -= n;
+    }
+    assert(isEmptyQueue(q) == (count == 0));
+  }
+  freeQueue(q);
+  oldFreeQueue(ref);
+}
+
+int main(int argc, char* argv[]) {
+  long ops = argc > 1 ? atol(argv[1]) : 100000000;
+  long burst = 1000000;
+  long rounds = ops / (2 * burst) > 0 ? ops / (2 * burst) : 1;
+  long checksum;
+  double start;
+
+  verify();
+  printf("verified against the previous queue\n");
+  printf("%ld operations per workload\n\n", 2 * burst * rounds);
+
+  /* steady state: a short queue, one enqueue and one dequeue per step */
+  OldQueue* oq = oldNewQueue();
+  checksum = 0;
+  start = now();
+  for (int i = 0; i < 1000; i++) {
+    oldEnqueue(i, oq);
+  }
+  for (long i = 0; i < burst * rounds; i++) {
+    oldEnqueue(i, oq);
+    checksum += oldDequeue(oq);
+  }
+  report("steady, old queue", 2 * burst * rounds, now() - start, checksum);
+  oldFreeQueue(oq);
+
+  Queue q = newQueue();
+  checksum = 0;
+  start = now();
+  for (int i = 0; i < 1000; i++) {
+    enqueue(i, q);
+  }
+  for (long i = 0; i < burst * rounds; i++) {
+    enqueue(i, q);
+    checksum += dequeue(q);
+  }
+  report("steady, ring", 2 * burst * rounds, now() - start, checksum);
+  freeQueue(q);
+
+  IntQueue* iq = newIntQueue(0);
+  checksum = 0;
+  start = now();
+  for (int i = 0; i < 1000; i++) {
+    enqueueIntQueue(i, iq);
+  }
+  for (long i = 0; i < burst * rounds; i++) {
+    enqueueIntQueue(i, iq);
+    checksum += dequeueIntQueue(iq);
+  }
+  report("steady, template inlined", 2 * burst * rounds, now() - start, checksum);
+  freeIntQueue(iq);
+
+  EventQueue* eq = newEventQueue(0);
+  checksum = 0;
+  start = now();
+  for (int i = 0; i < 1000; i++) {
+    Event e = {i, 0, i * 0.5};
+    enqueueEventQueue(e, eq);
+  }
+  for (long i = 0; i < burst * rounds; i++) {
+    Event e = {(int)i, 1, i * 0.5};
+    enqueueEventQueue(e, eq);
+    checksum += dequeueEventQueue(eq).id;
+  }
+  report("steady, template 16B struct", 2 * burst * rounds, now() - start, checksum);
+  freeEventQueue(eq);
+
+  /* bursts: fill a fresh queue with a BFS-frontier sized burst, then drain it */
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    oq = oldNewQueue();
+    for (long i = 0; i < burst; i++) {
+      oldEnqueue(i, oq);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += oldDequeue(oq);
+    }
+    oldFreeQueue(oq);
+  }
+  report("burst, old queue", 2 * burst * rounds, now() - start, checksum);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    q = newQueue();
+    for (long i = 0; i < burst; i++) {
+      enqueue(i, q);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += dequeue(q);
+    }
+    freeQueue(q);
+  }
+  report("burst, ring", 2 * burst * rounds, now() - start, checksum);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    q = newQueueWithCapacity(burst);
+    for (long i = 0; i < burst; i++) {
+      enqueue(i, q);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += dequeue(q);
+    }
+    freeQueue(q);
+  }
+  report("burst, ring + capacity", 2 * burst * rounds, now() - start, checksum);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    iq = newIntQueue(0);
+    for (long i = 0; i < burst; i++) {
+      enqueueIntQueue(i, iq);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += dequeueIntQueue(iq);
+    }
+    freeIntQueue(iq);
+  }
+  report("burst, template inlined", 2 * burst * rounds, now() - start, checksum);
+
+  int* items = malloc(BULK * sizeof(int));
+  assert(items != NULL);
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    q = newQueue();
+    for (long i = 0; i < burst; i += BULK) {
+      int n = burst - i < BULK ? burst - i : BULK;
+      for (int j = 0; j < n; j++) {
+        items[j] = i + j;
+      }
+      enqueueMany(items, n, q);
+    }
+    int n;
+    while ((n = dequeueMany(items, BULK, q)) > 0) {
+      for (int j = 0; j < n; j++) {
+        checksum += items[j];
+      }
+    }
+    freeQueue(q);
+  }
+  report("burst, ring bulk (256)", 2 * burst * rounds, now() - start, checksum);
+  free(items);
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file  benchspill.c
+ * @brief Throughput of a spilling LibQueue holding a backlog much larger
+ * than its memory budget: fill it, then drain it, checking FIFO order.
+ *
+ * usage: benchspill verify
+ *        benchspill [BUDGET_MIB [FACTOR|ram]]   (default 64 MiB, 10x)
+ *
+ * The backlog is FACTOR times the budget, or with "ram" ten times the
+ * physical memory of the machine, which needs that much free disk in
+ * $TMPDIR. Ordinary in-memory queue throughput is printed for reference.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LibQueue.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long peakRssKb(void) {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_maxrss;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+/* random bursts of single and bulk operations on a tiny budget, checked against a counter */
+int verify(void) {
+  Queue q = newSpillingQueue(4096);
+  int buffer[3000];
+  int next = 0, expect = 0;
+  uint64_t x = 88172645463325252u;
+  for (int round = 0; round < 20000; round++) {
+    uint64_t r = xorshift(&x);
+    int n = r % 3000;
+    int bulk = (r >> 20) & 1;
+    if ((r >> 16) % 2 == 0 || (round / 2000) % 2 == 0) {
+      if (bulk) {
+        for (int i = 0; i < n; i++) {
+          buffer[i] = next++;
+        }
+        enqueueMany(buffer, n, q);
+      } else {
+        for (int i = 0; i < n; i++) {
+          enqueue(next++, q);
+        }
+      }
+    } else {
+      int m = 0;
+      if (bulk) {
+        m = dequeueMany(buffer, n, q);
+      } else {
+        while (m < n && !isEmptyQueue(q)) {
+          buffer[m++] = dequeue(q);
+        }
+      }
+      for (int i = 0; i < m; i++) {
+        if (buffer[i] != expect) {
+          printf("verify: round %d: got %d, want %d\n", round, buffer[i], expect);
+          return 1;
+        }
+        expect++;
+      }
+    }
+    if (lengthQueue(q) != next - expect) {
+      printf("verify: round %d: length %ld, want %d\n", round, lengthQueue(q), next - expect);
+      return 1;
+    }
+    if (round == 15000) {
+      clearQueue(q);
+      expect = next;
+    }
+  }
+  freeQueue(q);
+  printf("verify: ok\n");
+  return 0;
+}
+
+void report(const char* name, long items, double seconds) {
+  printf("%-32s %8.1f Mitems/s %8.1f MiB/s\n", name, items / seconds * 1e-6, items * sizeof(int) / seconds / (1 << 20));
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  long budgetMiB = argc > 1 ? atol(argv[1]) : 64;
+  long budget = budgetMiB * (1 << 20) / sizeof(int);
+  long items;
+  if (argc > 2 && strcmp(argv[2], "ram") == 0) {
+    items = 10 * (sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE) / (long)sizeof(int));
+  } else {
+    items = (argc > 2 ? atol(argv[2]) : 10) * budget;
+  }
+  printf("spilling queue, %ld MiB budget, backlog of %ld items (%.1f GiB)\n", budgetMiB, items,
+         items * (double)sizeof(int) / (1 << 30));
+
+  /* reference: an ordinary queue of the budget size */
+  Queue mem = newQueue();
+  double start = now();
+  for (long i = 0; i < budget; i++) {
+    enqueue((int)i, mem);
+  }
+  long checksum = 0;
+  while (!isEmptyQueue(mem)) {
+    checksum += dequeue(mem);
+  }
+  report("in memory, fill + drain", 2 * budget, now() - start);
+  freeQueue(mem);
+
+  Queue q = newSpillingQueue(budget);
+  start = now();
+  for (long i = 0; i < items; i++) {
+    enqueue((int)i, q);
+  }
+  double filled = now();
+  report("spilling, fill", items, filled - start);
+  long wrong = 0;
+  for (long i = 0; i < items; i++) {
+    wrong += dequeue(q) != (int)i;
+  }
+  report("spilling, drain", items, now() - filled);
+  report("spilling, fill + drain", 2 * items, now() - start);
+  printf("%s, %s, peak RSS %ld MiB (checksum %ld)\n", wrong == 0 ? "FIFO order ok" : "FIFO order WRONG", isEmptyQueue(q) ? "empty" : "NOT empty",
+         peakRssKb() / 1024, checksum);
+  freeQueue(q);
+  return wrong != 0;
+}
@@ -2,7 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "libs/LibTree.h"
+#include "LibTree.h"
 
 // Goal: a function to remove an element from a search tree.
 // Use the pseudocode of "RemoveFromSearchTree" in the slides.
@@ -1,6 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include "libs/LibList.h"
+#include "LibList.h"
 
 // Write a function that removes the *last* occurrence
 // of a given integer in a list.
@@ -42,13 +42,14 @@ int main(void) {
   int count = 0;
   printf("How many numbers?\n");
   scanf("%d", &count);
-  List li = newEmptyList();
+  ListHandle h = newListHandle();
   printf("Please enter %d numbers, one per line:\n", count);
   int next = 0;
   for (int p = 0; p < count; p++) {
     scanf("%d", &next);
-    li = addItemAtPos(li, next, p);
+    appendItem(next, h);
   }
+  List li = detachList(h);
   printf("The given list is: ");
   printList(li);
   printf("\n");
@@ -0,0 +1,156 @@
+/**
+ * @file  benchskip.c
+ * @brief Ordered inserts into a SkipList against a List kept sorted with
+ * insertInOrder (as in graphsearch.c), with random items.
+ *
+ * "verify" checks random inserts, removals and searches against a sorted
+ * array, and that the same seed gives the same list shape (and so the
+ * same time). insertInOrder here is a loop: the recursive one in
+ * graphsearch.c would need a stack frame per node.
+ *
+ * usage: benchskip verify | benchskip [ITEMS [LIST_ITEMS]]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LibList.h"
+#include "LibSkipList.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+List insertInOrder(int x, List l) {
+  if (l == NULL || l->item > x) {
+    return addItem(x, l);
+  }
+  List p = l;
+  while (p->next != NULL && p->next->item <= x) {
+    p = p->next;
+  }
+  p->next = addItem(x, p->next);
+  return l;
+}
+
+void fail(const char* what, long step) {
+  fprintf(stderr, "mismatch in %s at step %ld\n", what, step);
+  exit(1);
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  int* model = malloc(20000 * sizeof(int));
+  int n = 0;
+  SkipList s = newSkipList(1);
+  for (long step = 0; step < 400000; step++) {
+    int r = (int)(xorshift(&x) % 100);
+    int value = (int)(xorshift(&x) % 2000) - 1000;
+    int i = 0;
+    while (i < n && model[i] < value) {
+      i++;
+    }
+    if (r < (step < 200000 ? 50 : 25) && n < 20000) {
+      while (i < n && model[i] == value) {
+        i++;
+      }
+      memmove(model + i + 1, model + i, (n - i) * sizeof(int));
+      model[i] = value;
+      n++;
+      insertSkip(value, s);
+    } else if (r < 75) {
+      int present = i < n && model[i] == value;
+      if (present) {
+        memmove(model + i, model + i + 1, (n - i - 1) * sizeof(int));
+        n--;
+      }
+      if (removeSkip(value, s) != present) {
+        fail("removeSkip", step);
+      }
+    } else if (isInSkip(value, s) != (i < n && model[i] == value)) {
+      fail("isInSkip", step);
+    }
+    if (lengthSkip(s) != n) {
+      fail("lengthSkip", step);
+    }
+    if (step % 1000 == 0) {
+      i = 0;
+      for (SkipNode* p = firstSkip(s); p != NULL; p = nextSkip(p), i++) {
+        if (i >= n || itemSkip(p) != model[i]) {
+          fail("iteration", step);
+        }
+      }
+    }
+  }
+  freeSkipList(s);
+  free(model);
+  printf("skip list matches the sorted array\n");
+  return 0;
+}
+
+double benchSkip(int n, uint64_t seed, long* checksum) {
+  uint64_t x = 88172645463325252u;
+  double t = now();
+  SkipList s = newSkipList(seed);
+  for (int i = 0; i < n; i++) {
+    insertSkip((int)(xorshift(&x) >> 33), s);
+  }
+  t = now() - t;
+  *checksum = 0;
+  for (SkipNode* p = firstSkip(s); p != NULL; p = nextSkip(p)) {
+    *checksum = *checksum * 31 + itemSkip(p);
+  }
+  freeSkipList(s);
+  return t;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  int maxItems = argc > 1 ? atoi(argv[1]) : 1000000;
+  int maxListItems = argc > 2 ? atoi(argv[2]) : 100000;
+  long checksum;
+  printf("%-26s %10s %12s %10s\n", "ordered insert", "items", "ns/insert", "Minserts/s");
+  for (int n = 1000; n <= maxItems; n *= 10) {
+    double t = benchSkip(n, 1, &checksum);
+    printf("%-26s %10d %12.1f %10.3f   (checksum %ld)\n", "SkipList", n, t * 1e9 / n, n / t * 1e-6, checksum);
+    if (n > maxListItems) {
+      continue;
+    }
+    uint64_t x = 88172645463325252u;
+    t = now();
+    List li = newEmptyList();
+    for (int i = 0; i < n; i++) {
+      li = insertInOrder((int)(xorshift(&x) >> 33), li);
+    }
+    t = now() - t;
+    checksum = 0;
+    for (List p = li; p != NULL; p = p->next) {
+      checksum = checksum * 31 + p->item;
+    }
+    freeList(li);
+    printf("%-26s %10d %12.1f %10.3f   (checksum %ld)\n", "List with insertInOrder", n, t * 1e9 / n, n / t * 1e-6,
+           checksum);
+  }
+
+  // the same seed gives the same levels, so the same work
+  double t1 = benchSkip(maxItems, 7, &checksum);
+  double t2 = benchSkip(maxItems, 7, &checksum);
+  printf("SkipList seed 7 twice: %.3f s and %.3f s\n", t1, t2);
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibSkipList.h"
+
+// Keep an ordered collection of numbers under a sequence of commands:
+//   + n   add n
+//   - n   remove one n, if there is one
+//   ? n   tell whether n is there
+// and print the numbers in order at the end. With a skip list every
+// command takes O(log n) expected time instead of a walk along a list.
+
+int main(void) {
+  int count = 0;
+  printf("How many commands?\n");
+  scanf("%d", &count);
+  SkipList s = newSkipList(2024);
+  printf("Please enter the commands, one per line:\n");
+  for (int i = 0; i < count; i++) {
+    char command;
+    int n;
+    if (scanf(" %c %d", &command, &n) != 2) {
+      break;
+    }
+    if (command == '+') {
+      insertSkip(n, s);
+    } else if (command == '-') {
+      if (!removeSkip(n, s)) {
+        printf("%d was not there\n", n);
+      }
+    } else if (command == '?') {
+      printf("%d is %s\n", n, isInSkip(n, s) ? "there" : "not there");
+    }
+  }
+  printf("The %d numbers in order: ", lengthSkip(s));
+  printSkip(s);
+  printf("\n");
+  freeSkipList(s);
+  exit(0);
+}
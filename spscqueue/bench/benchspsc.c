@@ -0,0 +1,142 @@
+/**
+ * @file  benchspsc.c
+ * @brief Throughput and latency of QueueSPSC between two pinned threads.
+ *
+ * Throughput: the producer streams ITEMS integers through one queue.
+ * Latency: two queues form a ping-pong loop and every round trip is timed;
+ * one-way latency is reported as half the round trip.
+ *
+ * usage: benchspsc [ITEMS] [ROUNDTRIPS] [PRODUCER_CPU] [CONSUMER_CPU]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LibQueueSPSC.h"
+
+#define CAPACITY 4096
+
+typedef struct Args {
+  QueueSPSC in;
+  QueueSPSC out;
+  long count;
+  int cpu;
+  long checksum;
+} Args;
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* pins the calling thread; with fewer CPUs than threads both share one */
+void pin(int cpu) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % (cpus > 0 ? cpus : 1), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/* spin on the try-variant, yielding now and then so one CPU also works */
+void push(int item, QueueSPSC q) {
+  for (int spins = 0; !tryEnqueueSPSC(item, q); spins++) {
+    if (spins % 64 == 63) {
+      sched_yield();
+    }
+  }
+}
+
+int pop(QueueSPSC q) {
+  int item;
+  for (int spins = 0; !tryDequeueSPSC(&item, q); spins++) {
+    if (spins % 64 == 63) {
+      sched_yield();
+    }
+  }
+  return item;
+}
+
+void* consume(void* arg) {
+  Args* a = arg;
+  pin(a->cpu);
+  long sum = 0;
+  for (long i = 0; i < a->count; i++) {
+    sum += pop(a->in);
+  }
+  a->checksum = sum;
+  return NULL;
+}
+
+void* echo(void* arg) {
+  Args* a = arg;
+  pin(a->cpu);
+  for (long i = 0; i < a->count; i++) {
+    push(pop(a->in), a->out);
+  }
+  return NULL;
+}
+
+int compareDoubles(const void* a, const void* b) {
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+  long items = argc > 1 ? atol(argv[1]) : 100000000;
+  long trips = argc > 2 ? atol(argv[2]) : 1000000;
+  int producerCpu = argc > 3 ? atoi(argv[3]) : 0;
+  int consumerCpu = argc > 4 ? atoi(argv[4]) : 1;
+  pthread_t thread;
+
+  printf("CPUs online: %ld, producer on %d, consumer on %d\n", sysconf(_SC_NPROCESSORS_ONLN), producerCpu, consumerCpu);
+  pin(producerCpu);
+
+  /* throughput */
+  QueueSPSC q = newQueueSPSC(CAPACITY);
+  Args a = {q, NULL, items, consumerCpu, 0};
+  double start = now();
+  pthread_create(&thread, NULL, consume, &a);
+  for (long i = 0; i < items; i++) {
+    push((int)i, q);
+  }
+  pthread_join(thread, NULL);
+  double seconds = now() - start;
+  long expected = 0;
+  for (long i = 0; i < items; i++) {
+    expected += (int)i;
+  }
+  printf("throughput: %ld items in %.3f s, %.1f Mitems/s, %.2f ns/item%s\n", items, seconds, items / seconds * 1e-6,
+         seconds * 1e9 / items, a.checksum == expected ? "" : "  CHECKSUM MISMATCH");
+  freeQueueSPSC(q);
+
+  /* latency */
+  QueueSPSC ping = newQueueSPSC(CAPACITY);
+  QueueSPSC pong = newQueueSPSC(CAPACITY);
+  double* rtt = malloc(trips * sizeof(double));
+  if (rtt == NULL) {
+    return 1;
+  }
+  Args b = {ping, pong, trips, consumerCpu, 0};
+  pthread_create(&thread, NULL, echo, &b);
+  for (long i = 0; i < trips; i++) {
+    double t = now();
+    push((int)i, ping);
+    pop(pong);
+    rtt[i] = now() - t;
+  }
+  pthread_join(thread, NULL);
+  qsort(rtt, trips, sizeof(double), compareDoubles);
+  printf("latency (one way): p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, max %.0f ns\n", rtt[trips / 2] * 0.5e9,
+         rtt[trips * 99 / 100] * 0.5e9, rtt[trips * 999 / 1000] * 0.5e9, rtt[trips - 1] * 0.5e9);
+  free(rtt);
+  freeQueueSPSC(ping);
+  freeQueueSPSC(pong);
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibQueueSPSC.h"
+
+// A parser thread reads numbers from the input and hands them to a
+// compute thread through a single-producer/single-consumer queue.
+// The queue is deliberately tiny, so both threads regularly have to
+// wait for each other. The value -1 tells the compute thread to stop.
+
+const int QUEUE_CAPACITY = 4;
+
+void* compute(void* arg) {
+  QueueSPSC q = arg;
+  long sum = 0;
+  int count = 0;
+  int n;
+  while ((n = dequeueSPSC(q)) != -1) {
+    sum += n;
+    count++;
+    printf("Received %d, running sum %ld.\n", n, sum);
+  }
+  printf("The compute thread received %d numbers with sum %ld.\n", count, sum);
+  return NULL;
+}
+
+int main(void) {
+  QueueSPSC q = newQueueSPSC(QUEUE_CAPACITY);
+  pthread_t consumer;
+  if (pthread_create(&consumer, NULL, compute, q) != 0) {
+    printf("Could not start the compute thread.\n");
+    exit(1);
+  }
+
+  int n;
+  while (scanf("%d", &n) == 1 && n != -1) {
+    enqueueSPSC(n, q);
+  }
+  enqueueSPSC(-1, q);
+
+  pthread_join(consumer, NULL);
+  freeQueueSPSC(q);
+  exit(0);
+}
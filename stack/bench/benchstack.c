@@ -0,0 +1,92 @@
+/**
+ * @file  benchstack.c
+ * @brief Compares the opaque LibStack calls against the same stack
+ * inlined from DEFINE_STACK, for int and for a struct payload.
+ *
+ * usage: benchstack [OPS]   (default 100000000)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LibStack.h"
+#include "LibStackTemplate.h"
+
+DEFINE_STACK(IntStack, int)
+
+/* a typical struct payload, stored unboxed */
+typedef struct Frame {
+  int node;
+  int depth;
+  double cost;
+} Frame;
+
+DEFINE_STACK(FrameStack, Frame)
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void report(const char* name, long ops, double seconds, long checksum) {
+  printf("%-28s %8.2f ns/op %9.1f Mops/s   (checksum %ld)\n", name, seconds * 1e9 / ops, ops / seconds * 1e-6, checksum);
+}
+
+int main(int argc, char* argv[]) {
+  long ops = argc > 1 ? atol(argv[1]) : 100000000;
+  long burst = 1000000;
+  long rounds = ops / (2 * burst) > 0 ? ops / (2 * burst) : 1;
+  long checksum;
+  double start;
+
+  printf("%ld operations per workload\n\n", 2 * burst * rounds);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    Stack st = newStack();
+    for (long i = 0; i < burst; i++) {
+      push(i, st);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += pop(st);
+    }
+    freeStack(st);
+  }
+  report("burst, LibStack (opaque)", 2 * burst * rounds, now() - start, checksum);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    IntStack* st = newIntStack(0);
+    for (long i = 0; i < burst; i++) {
+      pushIntStack(i, st);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += popIntStack(st);
+    }
+    freeIntStack(st);
+  }
+  report("burst, template inlined", 2 * burst * rounds, now() - start, checksum);
+
+  checksum = 0;
+  start = now();
+  for (long r = 0; r < rounds; r++) {
+    FrameStack* st = newFrameStack(0);
+    for (long i = 0; i < burst; i++) {
+      Frame f = {(int)i, 0, i * 0.5};
+      pushFrameStack(f, st);
+    }
+    for (long i = 0; i < burst; i++) {
+      checksum += popFrameStack(st).node;
+    }
+    freeFrameStack(st);
+  }
+  report("burst, template 16B struct", 2 * burst * rounds, now() - start, checksum);
+
+  return 0;
+}
@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "libs/LibStack.h"
+#include "LibStack.h"
 
 int main(void) {
   Stack s = newStack();
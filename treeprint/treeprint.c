@@ -3,7 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "libs/LibTree.h"
+#include "LibTree.h"
 
 // Write a function that prints a tree given in pointer representation.
 // For example, this tree:
@@ -0,0 +1,171 @@
+/**
+ * @file  benchunrolled.c
+ * @brief Unrolled list against the classic LibList at 10^7 items.
+ *
+ * "verify" runs random insertions and removals on both an UnrolledList
+ * and a plain array and compares them after every step. Otherwise each
+ * list is built, summed, searched and indexed, and the time per item is
+ * printed. Position lookups in the classic list use a loop here, because
+ * itemAtPos recurses once per position.
+ *
+ * usage: benchunrolled verify | benchunrolled [ITEMS]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LibList.h"
+#include "LibUnrolledList.h"
+
+double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint64_t xorshift(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+void check(int ok, const char* what, long step) {
+  if (!ok) {
+    fprintf(stderr, "mismatch in %s at step %ld\n", what, step);
+    exit(1);
+  }
+}
+
+int verify(void) {
+  uint64_t x = 88172645463325252u;
+  int capacity = 5000;
+  int* model = malloc(capacity * sizeof(int));
+  int n = 0;
+  UnrolledList u = newUnrolledList();
+  for (long step = 0; step < 200000; step++) {
+    // grow to a few thousand items, then shrink to nothing, twice
+    int growing = (step / 50000) % 2 == 0;
+    int r = (int)(xorshift(&x) % 100);
+    int value = (int)(xorshift(&x) % 1000);
+    if (n < capacity && (n == 0 || r < (growing ? 60 : 35))) {
+      int p = r % 3 == 0 ? 0 : r % 3 == 1 ? n : (int)(xorshift(&x) % (n + 1));
+      memmove(model + p + 1, model + p, (n - p) * sizeof(int));
+      model[p] = value;
+      n++;
+      if (p == 0) {
+        addItemUnrolled(value, u);
+      } else if (p == n - 1) {
+        appendUnrolled(u, value);
+      } else {
+        addItemAtPosUnrolled(u, value, p);
+      }
+    } else if (r % 2 == 0) {
+      memmove(model, model + 1, (n - 1) * sizeof(int));
+      n--;
+      removeFirstUnrolled(u);
+    } else {
+      value = model[xorshift(&x) % n];
+      int i = 0;
+      while (model[i] != value) {
+        i++;
+      }
+      memmove(model + i, model + i + 1, (n - i - 1) * sizeof(int));
+      n--;
+      removeItemUnrolled(u, value);
+    }
+    check(lengthUnrolled(u) == n, "length", step);
+    if (step % 97 == 0) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        check(itemAtPosUnrolled(u, i) == model[i], "itemAtPos", step);
+        sum += model[i];
+      }
+      check(sumUnrolled(u) == sum, "sum", step);
+      int present = 0;
+      for (int i = 0; i < n; i++) {
+        present |= model[i] == value;
+      }
+      check(isInUnrolled(value, u) == present, "isIn", step);
+    }
+  }
+  freeUnrolledList(u);
+  free(model);
+  printf("unrolled list matches the array model\n");
+  return 0;
+}
+
+void report(const char* container, const char* workload, double seconds, long items, long checksum) {
+  printf("%-9s %-30s %8.2f ns/item   (checksum %ld)\n", container, workload, seconds * 1e9 / items, checksum);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+    return verify();
+  }
+  long n = argc > 1 ? atol(argv[1]) : 10000000;
+  int lookups = 100;
+  uint64_t x = 88172645463325252u;
+  double t;
+
+  t = now();
+  List li = newEmptyList();
+  for (long i = n - 1; i >= 0; i--) {
+    li = addItem((int)i, li);
+  }
+  report("List", "build (addItem)", now() - t, n, 0);
+  t = now();
+  unsigned int total = 0;  // wraps around like sumUnrolled
+  for (List p = li; p != NULL; p = p->next) {
+    total += (unsigned int)p->item;
+  }
+  report("List", "sum", now() - t, n, total);
+  t = now();
+  int found = 0;
+  for (List p = li; p != NULL; p = p->next) {
+    if (p->item == -1) {
+      found = 1;
+      break;
+    }
+  }
+  report("List", "search for a missing item", now() - t, n, found);
+  t = now();
+  long sum = 0;
+  for (int i = 0; i < lookups; i++) {
+    long pos = (long)(xorshift(&x) % n);
+    List p = li;
+    while (pos-- > 0) {
+      p = p->next;
+    }
+    sum += p->item;
+  }
+  report("List", "item at a random position", now() - t, n * (long)lookups / 2, sum);
+  freeList(li);
+
+  x = 88172645463325252u;
+  t = now();
+  UnrolledList u = newUnrolledList();
+  for (long i = 0; i < n; i++) {
+    appendUnrolled(u, (int)i);
+  }
+  report("Unrolled", "build (appendUnrolled)", now() - t, n, 0);
+  t = now();
+  total = (unsigned int)sumUnrolled(u);
+  report("Unrolled", "sum", now() - t, n, total);
+  t = now();
+  found = isInUnrolled(-1, u);
+  report("Unrolled", "search for a missing item", now() - t, n, found);
+  t = now();
+  sum = 0;
+  for (int i = 0; i < lookups; i++) {
+    sum += itemAtPosUnrolled(u, (int)(xorshift(&x) % n));
+  }
+  report("Unrolled", "item at a random position", now() - t, n * (long)lookups / 2, sum);
+  freeUnrolledList(u);
+  return 0;
+}
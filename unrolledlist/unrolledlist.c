@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibUnrolledList.h"
+
+// Josephus problem: n people numbered 1 .. n stand in a circle, and
+// counting around the circle every k-th person leaves. Print the numbers
+// in the order in which they leave. The circle is an unrolled list, so
+// finding the person at a position skips 28 people per node, and removing
+// a person only shifts the items of one node.
+
+void josephus(int n, int k) {
+  UnrolledList circle = newUnrolledList();
+  for (int i = 1; i <= n; i++) {
+    appendUnrolled(circle, i);
+  }
+  int pos = 0;
+  while (!isEmptyUnrolled(circle)) {
+    pos = (pos + k - 1) % lengthUnrolled(circle);
+    int person = itemAtPosUnrolled(circle, pos);
+    printf("%d\n", person);
+    removeItemUnrolled(circle, person);
+  }
+  freeUnrolledList(circle);
+}
+
+int main(void) {
+  int n = 0;
+  int k = 0;
+  printf("How many people?\n");
+  scanf("%d", &n);
+  printf("Which person in the count leaves?\n");
+  scanf("%d", &k);
+  printf("The people leave in this order:\n");
+  josephus(n, k);
+  exit(0);
+}
@@ -0,0 +1,148 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LibDequeWS.h"
+#include "LibScheduler.h"
+
+// Stress test for the work-stealing deque, then a small scheduler run.
+// The owner pushes the items 0, ..., N-1 and pops some of them back in a
+// random pattern given by the seed, starting from a deque of capacity 2 so that it grows
+// many times while the thieves keep stealing. We check that every item
+// was taken exactly once, by the owner or by exactly one thief.
+// The scheduler then computes fib(F) by spawning the tasks n-1 and n-2
+// for every task n >= 2, and adding up the leaves per worker.
+
+typedef struct Shared {
+  DequeWS d;
+  int items;
+  uint64_t seed;       // for the push/pop pattern of the owner
+  atomic_int* taken;  // how often each item was taken
+  atomic_bool ownerDone;
+} Shared;
+
+uint64_t nextRandom(uint64_t* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+void* owner(void* arg) {
+  Shared* s = arg;
+  uint64_t x = 88172645463325252u ^ s->seed;
+  int item;
+  for (int next = 0; next < s->items;) {
+    uint64_t r = nextRandom(&x);
+    // bursts of pushes followed by bursts of pops
+    int burst = 1 + (int)(r % 16);
+    if ((r >> 8) % 3 != 0) {
+      for (int i = 0; i < burst && next < s->items; i++) {
+        pushDequeWS(next++, s->d);
+      }
+    } else {
+      for (int i = 0; i < burst; i++) {
+        if (popDequeWS(&item, s->d)) {
+          atomic_fetch_add(&s->taken[item], 1);
+        }
+      }
+    }
+  }
+  while (popDequeWS(&item, s->d)) {
+    atomic_fetch_add(&s->taken[item], 1);
+  }
+  atomic_store(&s->ownerDone, true);
+  return NULL;
+}
+
+void* thief(void* arg) {
+  Shared* s = arg;
+  int item;
+  while (!atomic_load(&s->ownerDone)) {
+    if (stealDequeWS(&item, s->d)) {
+      atomic_fetch_add(&s->taken[item], 1);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+void fibTask(int n, int worker, Scheduler s, void* context) {
+  long* leaves = context;
+  if (n < 2) {
+    leaves[worker] += n;
+  } else {
+    spawnTask(n - 1, worker, s);
+    spawnTask(n - 2, worker, s);
+  }
+}
+
+int main(void) {
+  int thieves, items, workers, fib;
+  unsigned long seed;
+  printf("How many thieves, items, scheduler workers, which Fibonacci number and what seed?\n");
+  if (scanf("%d %d %d %d %lu", &thieves, &items, &workers, &fib, &seed) != 5) {
+    exit(1);
+  }
+
+  Shared s;
+  s.d = newDequeWS(2);
+  s.items = items;
+  s.seed = seed;
+  s.taken = calloc(items, sizeof(atomic_int));
+  atomic_init(&s.ownerDone, false);
+
+  // thieves whose thread cannot be created are left out; an owner without
+  // a thread runs here once the thieves are started
+  pthread_t* threads = malloc((thieves + 1) * sizeof(pthread_t));
+  bool* started = malloc((thieves + 1) * sizeof(bool));
+  started[0] = pthread_create(&threads[0], NULL, owner, &s) == 0;
+  for (int t = 1; t <= thieves; t++) {
+    started[t] = pthread_create(&threads[t], NULL, thief, &s) == 0;
+  }
+  if (!started[0]) {
+    owner(&s);
+  }
+  for (int t = 0; t <= thieves; t++) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    }
+  }
+  free(started);
+
+  int missing = 0, duplicated = 0;
+  for (int i = 0; i < items; i++) {
+    int n = atomic_load(&s.taken[i]);
+    missing += (n == 0);
+    duplicated += (n > 1);
+  }
+  printf("The owner and %d thieves took %d items from a growing deque.\n", thieves, items);
+  if (missing == 0 && duplicated == 0) {
+    printf("Every item was taken exactly once.\n");
+  } else {
+    printf("%d items were lost and %d were taken more than once!\n", missing, duplicated);
+  }
+  printf("The deque is %s.\n", isEmptyDequeWS(s.d) ? "empty" : "not empty");
+
+  long* leaves = calloc(workers, sizeof(long));
+  Scheduler sched = newScheduler(workers, fibTask, leaves);
+  spawnTask(fib, 0, sched);
+  runScheduler(sched);
+  long sum = 0;
+  for (int w = 0; w < workers; w++) {
+    sum += leaves[w];
+  }
+  printf("%d workers computed fib(%d) = %ld.\n", workers, fib, sum);
+
+  freeScheduler(sched);
+  free(leaves);
+  free(threads);
+  free(s.taken);
+  freeDequeWS(s.d);
+  exit(0);
+}